@@ -0,0 +1,222 @@
+/**
+ * Spline benchmark suite.
+ *
+ * Measures QuadraticSpline::generate / compute (uniform and non-uniform knots, sorted and random
+ * queries) as well as CurvatureSpline and GradientSpline generation for float and double over knot
+ * counts from 8 to 10^7. Results are written as CSV to stdout, progress goes to stderr:
+ *
+ *      label,value_t,spline,layout,knots,benchmark,order,ns_per_item,items_per_s,bytes_per_knot
+ *
+ * generate items are knots, compute items are evaluations. The math headers do not depend on the
+ * engine, so the benchmark builds standalone, e.g.:
+ *
+ *      cl /O2 /EHsc /std:c++17 /I my/include/My my/benchmark/SplineBenchmark.cpp
+ *      g++ -O2 -std=c++17 -pthread -I my/include/My my/benchmark/SplineBenchmark.cpp
+ *
+ * Options:
+ *      --label <text>      Value of the label column (e.g. the commit hash).
+ *      --max-knots <n>     Largest knot count (default: 10000000).
+ *      --queries <n>       Number of queries per compute benchmark (default: 1048576).
+ *      --min-time <s>      Minimum measured time per benchmark (default: 0.2).
+ *
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Math/CurvatureSpline.h"
+#include "Math/GradientSpline.h"
+#include "Math/QuadraticSpline.h"
+
+using namespace My::Math;
+
+namespace
+{
+
+struct Settings
+{
+    std::string label;
+    size_t max_knots{10000000};
+    size_t queries{size_t(1) << 20};
+    double min_time{0.2};
+};
+
+/**
+ * @brief   Best time in seconds of a single call of f. Runs at least three times and until
+ *          min_time has passed.
+ */
+template <typename func_t> double measure(func_t && f, double min_time)
+{
+    using clock = std::chrono::steady_clock;
+
+    double best{1e30}, total{0};
+    for (size_t run = 0; run < 3 || total < min_time; ++run)
+    {
+        const auto start{clock::now()};
+        f();
+        const double seconds{std::chrono::duration<double>(clock::now() - start).count()};
+        best = std::min(best, seconds);
+        total += seconds;
+    }
+    return best;
+}
+
+template <typename value_t> const char * typeName()
+{
+    return sizeof(value_t) == sizeof(float) ? "float" : "double";
+}
+
+template <typename value_t>
+void report(const Settings & settings, const char * spline, const char * layout, size_t knots,
+            const char * benchmark, const char * order, double seconds, size_t items,
+            double bytes_per_knot)
+{
+    const double ns{seconds * 1e9 / double(items)};
+    std::printf("%s,%s,%s,%s,%zu,%s,%s,%.4f,%.6e,%.2f\n", settings.label.c_str(),
+                typeName<value_t>(), spline, layout, knots, benchmark, order, ns, 1e9 / ns,
+                bytes_per_knot);
+    std::fflush(stdout);
+}
+
+template <typename value_t> double bytesPerKnot(const QuadraticSpline<value_t> & spline)
+{
+    const size_t n{spline.numKnots()};
+    return double(sizeof(value_t) * (2 * n + 3 * (n - 1))) / double(n); // x, y, coefficients
+}
+
+/**
+ * @brief   QuadraticSpline generate and compute with the given knot layout.
+ */
+template <typename value_t>
+void benchmarkQuadratic(const Settings & settings, size_t knots, bool uniform, std::mt19937 & rng)
+{
+    std::uniform_real_distribution<double> unit{0, 1};
+    const char * layout{uniform ? "uniform" : "non-uniform"};
+
+    std::unique_ptr<QuadraticSpline<value_t>> spline;
+    if (uniform)
+        spline = std::make_unique<QuadraticSpline<value_t>>(
+            knots, Intervall<value_t>{0, value_t(knots - 1)});
+    else
+    {
+        std::vector<value_t> x(knots), y(knots, 0);
+        for (size_t i = 1; i < knots; ++i) x[i] = x[i - 1] + value_t(0.5 + unit(rng));
+        spline = std::make_unique<QuadraticSpline<value_t>>(std::move(x), std::move(y));
+    }
+    for (size_t i = 0; i < knots; ++i) spline->specify(i, value_t(unit(rng)));
+
+    const double generate{measure([&] { spline->generate(); }, settings.min_time)};
+    const double bytes{bytesPerKnot(*spline)};
+    report<value_t>(settings, "QuadraticSpline", layout, knots, "generate", "-", generate, knots,
+                    bytes);
+
+    // queries strictly inside the intervall
+    const Intervall<value_t> intervall{spline->intervall()};
+    std::vector<value_t> queries(settings.queries);
+    for (auto & q : queries)
+        q = std::min(intervall._start + value_t(unit(rng)) * (intervall._end - intervall._start),
+                     std::nextafter(intervall._end, intervall._start));
+
+    for (const char * order : {"random", "sorted"})
+    {
+        if (order[0] == 's') std::sort(queries.begin(), queries.end());
+
+        value_t sink{0};
+        const double compute{measure(
+            [&] {
+                for (const value_t q : queries) sink += spline->compute(q);
+            },
+            settings.min_time)};
+        report<value_t>(settings, "QuadraticSpline", layout, knots, "compute", order, compute,
+                        queries.size(), bytes);
+
+        if (sink == value_t(-1)) std::cerr << sink; // keep the evaluations alive
+    }
+}
+
+template <typename value_t>
+void benchmarkCurvature(const Settings & settings, size_t knots, std::mt19937 & rng)
+{
+    std::uniform_real_distribution<double> unit{-1, 1};
+
+    CurvatureSpline<value_t> spline{knots - 1, 0, 1, Intervall<value_t>{0, 1}};
+    for (size_t i = 0; i < spline.numCurvatures(); ++i)
+        spline.curvature(i, value_t(unit(rng)));
+
+    const double generate{measure([&] { spline.generate(); }, settings.min_time)};
+    const double bytes{bytesPerKnot(spline) +
+                       double(sizeof(value_t) * spline.numCurvatures()) / double(knots)};
+    report<value_t>(settings, "CurvatureSpline", "uniform", knots, "generate", "-", generate,
+                    knots, bytes);
+}
+
+template <typename value_t>
+void benchmarkGradient(const Settings & settings, size_t knots, std::mt19937 & rng)
+{
+    std::uniform_real_distribution<double> unit{-1, 1};
+
+    GradientSpline<value_t> spline{knots - 2, Intervall<value_t>{0, 1}, 0, 1};
+    for (size_t i = 1; i + 1 < knots; ++i) spline.specify(i, value_t(unit(rng)));
+
+    const double generate{measure([&] { spline.generate(); }, settings.min_time)};
+    report<value_t>(settings, "GradientSpline", "uniform", knots, "generate", "-", generate, knots,
+                    bytesPerKnot(spline));
+}
+
+template <typename value_t> void run(const Settings & settings, const std::vector<size_t> & knots)
+{
+    std::mt19937 rng{42};
+    for (const size_t n : knots)
+    {
+        std::cerr << "> " << typeName<value_t>() << ", " << n << " knots\n";
+        benchmarkQuadratic<value_t>(settings, n, true, rng);
+        benchmarkQuadratic<value_t>(settings, n, false, rng);
+        benchmarkCurvature<value_t>(settings, n, rng);
+        benchmarkGradient<value_t>(settings, n, rng);
+    }
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    Settings settings;
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool has_value{i + 1 < argc};
+        if (!std::strcmp(argv[i], "--label") && has_value)
+            settings.label = argv[++i];
+        else if (!std::strcmp(argv[i], "--max-knots") && has_value)
+            settings.max_knots = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--queries") && has_value)
+            settings.queries = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        else if (!std::strcmp(argv[i], "--min-time") && has_value)
+            settings.min_time = std::strtod(argv[++i], nullptr);
+        else
+        {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--label text] [--max-knots n] [--queries n] [--min-time s]\n";
+            return 1;
+        }
+    }
+
+    // 8, 64, ..., 8^7 and 10^7
+    std::vector<size_t> knots;
+    for (size_t n = 8; n <= settings.max_knots && n < 10000000; n *= 8) knots.push_back(n);
+    if (settings.max_knots >= 10000000) knots.push_back(10000000);
+
+    std::printf("label,value_t,spline,layout,knots,benchmark,order,ns_per_item,items_per_s,"
+                "bytes_per_knot\n");
+    run<float>(settings, knots);
+    run<double>(settings, knots);
+    return 0;
+}
@@ -6,6 +6,7 @@
 #include "My/Engine/EntityManager.h"
 #include "My/Engine/MaterialStructures.h"
 #include "My/Engine/System.h"
+#include "My/Engine/View.h"
 
 #include "My/D3D11RenderSystem/HLSLShaderProgram.h"
 #include "My/D3D11RenderSystem/Shader/ShaderConstants.h"
@@ -76,8 +77,14 @@ private:
 
     winrt::com_ptr<ID3D11DepthStencilState> _reversed_zdepth_no_stencil_test{nullptr};
 
-    std::vector<winrt::com_ptr<ID3D11Buffer>> _vertex_buffers;
-    std::vector<winrt::com_ptr<ID3D11Buffer>> _index_buffers;
+    struct MeshBuffers
+    {
+        winrt::com_ptr<ID3D11Buffer> Vertices;
+        winrt::com_ptr<ID3D11Buffer> Indices;
+    };
+
+    ComponentStorage<MeshBuffers> _mesh_buffers; // GPU buffers of the MeshComponent of an entity
+    uint32_t _mesh_version{0};                   // mesh changes uploaded so far
 
     std::unique_ptr<HLSLShaderProgram> _pbr_shader{nullptr};
     winrt::com_ptr<ID3D11InputLayout> _pbr_input_layout;
@@ -132,6 +139,8 @@ public:
 private:
     void UpdateComponents(ComponentManager & manager);
 
+    MeshBuffers CreateMeshBuffers(const MeshComponent & component);
+
     std::vector<VERTEX_DATA> MakeData(const MeshComponent & component);
 
     void CreateD3D11DeviceAndContext(IDXGIAdapter1 * adapter,
@@ -10,4 +10,13 @@ inline DirectX::XMVECTOR cvx(glm::vec3 v) { return DirectX::XMVectorSet(v.x, v.y
 inline DirectX::XMFLOAT2 cv(glm::vec2 v) { return {v.x, v.y}; }
 inline DirectX::XMVECTOR cvx(glm::quat q) { return DirectX::XMVectorSet(q.x, q.y, q.z, q.w); }
 
+/**
+ * @brief   The column-major glm matrix (column vectors) has the memory layout of the row-major
+ *          DirectX matrix for row vectors, so no transpose is needed.
+ */
+inline DirectX::XMMATRIX cvx(const glm::mat4 & m)
+{
+    return DirectX::XMLoadFloat4x4(reinterpret_cast<const DirectX::XMFLOAT4X4 *>(&m));
+}
+
 } // namespace My::D3D11RenderSystem
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "pch.h"
+
+#include "My/Engine/Component.h"
+#include "My/Math/VectorSpline.h"
+
+namespace My::Engine
+{
+
+namespace _implementation
+{
+
+/**
+ * @brief   An entity transform channel driven by a SplineAnimationComponent.
+ */
+enum class AnimationChannel
+{
+    Position, // spline value is the position
+    Rotation, // spline value is (yaw, pitch, roll) in radians, see My::Math::RollPitchYaw
+    Scale     // spline value is the scale
+};
+
+constexpr size_t NumAnimationChannels{3};
+
+using AnimationCurve = My::Math::VectorSpline<float, 3>;
+
+/**
+ * @brief   Playback state of one channel of a SplineAnimationComponent.
+ */
+struct AnimationTrack
+{
+    std::shared_ptr<const AnimationCurve> Curve; // shared between tracks, evaluated batched
+
+    float Time{0.f};  // playback position within the curve intervall
+    float Speed{1.f}; // curve units per second (negative plays backwards)
+    bool Loop{true};  // wrap around at the ends instead of stopping
+};
+
+/**
+ * @brief   Plays back generated 3D splines on the transform channels of the parent entity, one
+ *          track per channel. Tracks without a curve leave their channel untouched. Only Active
+ *          components are updated (see AnimationSystem).
+ */
+struct SplineAnimationComponent : public Component
+{
+    std::array<AnimationTrack, NumAnimationChannels> Tracks; // indexed by AnimationChannel
+
+    AnimationTrack & Track(AnimationChannel channel) { return Tracks[size_t(channel)]; }
+
+    const AnimationTrack & Track(AnimationChannel channel) const
+    {
+        return Tracks[size_t(channel)];
+    }
+};
+
+} // namespace _implementation
+
+using _implementation::AnimationChannel;
+using _implementation::AnimationCurve;
+using _implementation::AnimationTrack;
+using _implementation::NumAnimationChannels;
+using _implementation::SplineAnimationComponent;
+
+} // namespace My::Engine
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "pch.h"
+
+#include "My/Engine/AnimationComponents.h"
+#include "My/Engine/ComponentManager.h"
+#include "My/Engine/EntityManager.h"
+#include "My/Engine/System.h"
+
+#include "My/Math/GLMHelpers.h"
+#include "My/Utility/JobSystem.h"
+
+namespace My::Engine
+{
+
+namespace _implementation
+{
+
+/**
+ * @brief   Advances and evaluates all active SplineAnimationComponents once per frame.
+ *
+ * The tracks are kept grouped by curve, so each curve is evaluated with the batched
+ * VectorSpline::compute on chunks of playback times and its coefficients stay in cache. Large
+ * numbers of animations are split into contiguous blocks evaluated on the job system, the tracks
+ * of one entity may be applied by different jobs (each writes its own channel).
+ */
+class AnimationSystem : public System
+{
+    // Data //
+public:
+    size_t MinAnimationsPerJob{1024}; // set to SIZE_MAX to always run on the calling thread
+
+private:
+    static constexpr size_t Chunk{64};
+
+    std::vector<size_t> _order; // tracks (component * NumAnimationChannels + channel) by curve
+    uint32_t _version{0};       // storage version of _order
+
+    // Interface //
+public:
+    SystemAccess Access() const override
+    {
+        return SystemAccess{0, MaskOf(ComponentType::SplineAnimationComponent) | TransformMask};
+    }
+
+    void Update(const SystemContext & context) override
+    {
+        Update(context.DeltaTime, context.Entities, context.Components, context.Jobs);
+    }
+
+    /**
+     * @brief   Advances the playback times by delta_time seconds and writes the animated channels
+     *          into the parent entities.
+     */
+    void Update(float delta_time, EntityManager & entity_manager,
+                ComponentManager & component_manager, Utility::JobSystem & jobs)
+    {
+        auto & animations = component_manager.GetSplineAnimationComponentData();
+        if (animations.Version() != _version) Regroup(component_manager);
+
+        jobs.ParallelFor(
+            0, _order.size(),
+            [&](size_t begin, size_t end) {
+                size_t index[Chunk];
+                float times[Chunk];
+                AnimationCurve::point_t values[Chunk];
+                while (begin < end)
+                {
+                    if (!Animated(animations, _order[begin]))
+                    {
+                        ++begin;
+                        continue;
+                    }
+
+                    // gather a run of active tracks sharing the curve
+                    const AnimationCurve & curve = *Track(animations, _order[begin]).Curve;
+                    size_t m = 0;
+                    for (; m < Chunk && begin < end; ++begin)
+                    {
+                        auto & track = Track(animations, _order[begin]);
+                        if (track.Curve.get() != &curve) break;
+                        if (!animations[_order[begin] / NumAnimationChannels].Active) continue;
+
+                        index[m] = _order[begin];
+                        times[m++] = Advance(track, curve, delta_time);
+                    }
+
+                    curve.compute(times, values, m);
+
+                    for (size_t k = 0; k < m; ++k)
+                    {
+                        const auto & animation = animations[index[k] / NumAnimationChannels];
+                        Apply(AnimationChannel(index[k] % NumAnimationChannels), values[k],
+                              entity_manager, animation.Parent);
+                    }
+                }
+            },
+            MinAnimationsPerJob);
+    }
+
+    /**
+     * @brief   Collects the tracks with a curve and groups them by curve. Happens automatically
+     *          when animations are added, removed or changed through ComponentStorage::Modify. Call
+     *          it after assigning curves directly.
+     */
+    void Regroup(const ComponentManager & component_manager)
+    {
+        const auto & animations = component_manager.GetSplineAnimationComponentData();
+
+        _order.clear();
+        for (size_t track = 0; track < animations.Size() * NumAnimationChannels; ++track)
+            if (Track(animations, track).Curve) _order.push_back(track);
+        std::stable_sort(_order.begin(), _order.end(), [&](size_t a, size_t b) {
+            return std::less<const AnimationCurve *>()(Track(animations, a).Curve.get(),
+                                                       Track(animations, b).Curve.get());
+        });
+        _version = animations.Version();
+    }
+
+private:
+    static AnimationTrack & Track(ComponentStorage<SplineAnimationComponent> & animations,
+                                  size_t track)
+    {
+        return animations[track / NumAnimationChannels].Tracks[track % NumAnimationChannels];
+    }
+
+    static const AnimationTrack &
+    Track(const ComponentStorage<SplineAnimationComponent> & animations, size_t track)
+    {
+        return animations[track / NumAnimationChannels].Tracks[track % NumAnimationChannels];
+    }
+
+    static bool Animated(const ComponentStorage<SplineAnimationComponent> & animations,
+                         size_t track)
+    {
+        return animations[track / NumAnimationChannels].Active && Track(animations, track).Curve;
+    }
+
+    static float Advance(AnimationTrack & track, const AnimationCurve & curve, float delta_time)
+    {
+        const auto range = curve.intervall();
+        float t = track.Time + track.Speed * delta_time;
+        if (track.Loop)
+        {
+            const float length = range._end - range._start;
+            t -= length * std::floor((t - range._start) / length);
+        }
+        else
+            t = std::clamp(t, range._start, range._end);
+
+        track.Time = t;
+        return t;
+    }
+
+    static void Apply(AnimationChannel channel, const AnimationCurve::point_t & v,
+                      EntityManager & entity_manager, EntityReference entity)
+    {
+        switch (channel)
+        {
+        case AnimationChannel::Position:
+            entity_manager.Position(entity) = glm::vec3(v[0], v[1], v[2]);
+            break;
+        case AnimationChannel::Rotation:
+            entity_manager.Rotation(entity) = My::Math::RollPitchYaw(v[0], v[1], v[2]);
+            break;
+        case AnimationChannel::Scale:
+            entity_manager.Scale(entity) = glm::vec3(v[0], v[1], v[2]);
+            break;
+        }
+    }
+};
+
+} // namespace _implementation
+
+using _implementation::AnimationSystem;
+
+} // namespace My::Engine
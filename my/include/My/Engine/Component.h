@@ -6,10 +6,23 @@ namespace My::Engine
 namespace _implementation
 {
 
-struct Entity;
+/**
+ * @brief   Generational entity handle. The generation of a slot is increased when its entity is
+ *          destroyed, so references to destroyed entities can be detected (EntityManager::Valid).
+ */
 struct EntityReference
 {
-    size_t Index;
+    static constexpr uint32_t InvalidIndex{UINT32_MAX};
+
+    uint32_t Index{InvalidIndex};
+    uint32_t Generation{0};
+
+    bool operator==(const EntityReference & o) const
+    {
+        return Index == o.Index && Generation == o.Generation;
+    }
+
+    bool operator!=(const EntityReference & o) const { return !(*this == o); }
 };
 
 struct Component
@@ -18,7 +31,6 @@ struct Component
 public:
     EntityReference Parent;
     bool Active{false};
-    // TODO: Local transform?
 
     // Interface Requirement //
 public:
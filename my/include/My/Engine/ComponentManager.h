@@ -2,7 +2,9 @@
 
 #include "pch.h"
 
+#include "My/Engine/AnimationComponents.h"
 #include "My/Engine/Component.h"
+#include "My/Engine/ComponentStorage.h"
 #include "My/Engine/Entity.h"
 #include "My/Engine/EntityManager.h"
 #include "My/Engine/LightComponents.h"
@@ -16,30 +18,121 @@ namespace My::Engine
 namespace _implementation
 {
 
+/**
+ * @brief   ComponentStorage owned by the ComponentManager. Adding and removing components is
+ *          reserved to the manager, which keeps the component masks of the entities in sync.
+ */
+template <typename comp_t> class ManagedStorage : public ComponentStorage<comp_t>
+{
+    friend class ComponentManager;
+
+public:
+    using ComponentStorage<comp_t>::ComponentStorage;
+
+private:
+    using ComponentStorage<comp_t>::Add;
+    using ComponentStorage<comp_t>::Remove;
+};
+
 #define REGISTER_COMPONENT(comp_t)                                                                 \
 private:                                                                                           \
-    std::vector<comp_t> COMBINE(_##comp_t, Data);                                                  \
+    ManagedStorage<comp_t> COMBINE(_##comp_t, Data){true}; /* with change tracking */              \
                                                                                                    \
 public:                                                                                            \
     ComponentReference RegisterComponent(EntityManager & eman, EntityReference e_ref,              \
                                          comp_t component)                                         \
     {                                                                                              \
-        component.Parent = e_ref;                                                                  \
-        COMBINE(_##comp_t, Data).push_back(component);                                             \
-        ComponentReference ref{COMBINE(_##comp_t, Data).size() - 1, ComponentType::comp_t};        \
-        eman[e_ref.Index].Components.push_back(ref);                                               \
-        return ref;                                                                                \
+        if (!eman.Valid(e_ref)) throw std::runtime_error("Entity is not valid.");                  \
+        auto & storage = StorageOf(static_cast<const comp_t *>(nullptr));                          \
+        storage.Add(e_ref, std::move(component)); /* replaces an existing one */                   \
+        eman.SetHasComponent(e_ref, ComponentType::comp_t, true);                                  \
+        return ComponentReference{e_ref, ComponentType::comp_t};                                   \
+    }                                                                                              \
+    const ManagedStorage<comp_t> & COMBINE(Get##comp_t, Data)() const                              \
+    {                                                                                              \
+        return StorageOf(static_cast<const comp_t *>(nullptr));                                    \
     }                                                                                              \
-    const std::vector<comp_t> & COMBINE(Get##comp_t, Data)() const                                 \
+    ManagedStorage<comp_t> & COMBINE(Get##comp_t, Data)()                                          \
     {                                                                                              \
+        return StorageOf(static_cast<const comp_t *>(nullptr));                                    \
+    }                                                                                              \
+                                                                                                   \
+private:                                                                                           \
+    ManagedStorage<comp_t> & StorageOf(const comp_t *)                                             \
+    {                                                                                              \
+        CheckAccess(MaskOf(ComponentType::comp_t), true);                                          \
         return COMBINE(_##comp_t, Data);                                                           \
-    }
+    }                                                                                              \
+    const ManagedStorage<comp_t> & StorageOf(const comp_t *) const                                 \
+    {                                                                                              \
+        CheckAccess(MaskOf(ComponentType::comp_t), false);                                         \
+        return COMBINE(_##comp_t, Data);                                                           \
+    }                                                                                              \
+    static constexpr ComponentType TypeOf(const comp_t *) { return ComponentType::comp_t; }
 
 class ComponentManager
 {
-    // NEW COMPONENT --> HERE
-    REGISTER_COMPONENT(MeshComponent)
-    REGISTER_COMPONENT(PointLightComponent)
+    COMPONENT_TYPES(REGISTER_COMPONENT)
+
+public:
+    /**
+     * @brief   Sparse set storage of a component type, e.g. for lookups by entity.
+     */
+    template <typename comp_t> ManagedStorage<comp_t> & Storage()
+    {
+        return StorageOf(static_cast<const comp_t *>(nullptr));
+    }
+
+    template <typename comp_t> const ManagedStorage<comp_t> & Storage() const
+    {
+        return StorageOf(static_cast<const comp_t *>(nullptr));
+    }
+
+    /**
+     * @brief   Removes the component of type comp_t from the entity.
+     *
+     * @return  Whether the entity had one (false for an invalid reference).
+     */
+    template <typename comp_t> bool RemoveComponent(EntityManager & eman, EntityReference e_ref)
+    {
+        if (!eman.Valid(e_ref) || !Storage<comp_t>().Remove(e_ref)) return false;
+        eman.SetHasComponent(e_ref, TypeOf(static_cast<const comp_t *>(nullptr)), false);
+        return true;
+    }
+
+    /**
+     * @brief   Ends the frame of the change streams of all component types, call once per frame.
+     */
+    void NextFrame()
+    {
+#define NEXT_FRAME(comp_t) Storage<comp_t>().NextFrame();
+        COMPONENT_TYPES(NEXT_FRAME)
+#undef NEXT_FRAME
+    }
+
+    /**
+     * @brief   Removes all components of the entity (O(1) each) and destroys it.
+     */
+    void DestroyEntity(EntityManager & eman, EntityReference e_ref)
+    {
+        if (!eman.Valid(e_ref)) return;
+
+        const ComponentMask mask = eman.Mask(e_ref);
+        for (uint32_t type = 0; mask >> type; ++type)
+        {
+            if (!(mask & MaskOf(static_cast<ComponentType>(type)))) continue;
+
+#define REMOVE(comp_t)                                                                             \
+    case ComponentType::comp_t: Storage<comp_t>().Remove(e_ref); break;
+
+            switch (static_cast<ComponentType>(type))
+            {
+                COMPONENT_TYPES(REMOVE)
+            }
+#undef REMOVE
+        }
+        eman.DestroyEntity(e_ref);
+    }
 };
 
 } // namespace _implementation
@@ -0,0 +1,300 @@
+#pragma once
+
+#include "pch.h"
+
+#include "My/Engine/Component.h"
+
+namespace My::Engine
+{
+
+namespace _implementation
+{
+
+enum class ChangeType : uint8_t
+{
+    Added,
+    Modified,
+    Removed
+};
+
+/**
+ * @brief   Entry of the change stream of a ComponentStorage.
+ */
+struct ChangeEvent
+{
+    EntityReference Entity;
+    uint32_t Version; // storage version after the change
+    ChangeType Type;
+};
+
+/**
+ * @brief   Sparse set holding at most one component of type comp_t per entity.
+ *
+ * The components are tightly packed in a dense array (iteration order), a second dense array
+ * stores their entities. A paged sparse array maps entity indices to dense indices, so insert,
+ * lookup and removal are O(1). Removal moves the last component into the hole (swap-remove), i.e.
+ * dense indices are not stable, the entity is the stable handle of a component.
+ *
+ * With change tracking enabled, additions, modifications (see Modify) and removals are appended to
+ * a compact change stream. Each change increments the storage version, consumers remember the
+ * version they have seen and process only the later changes (Changes). NextFrame drops the changes
+ * older than the previous frame. Writes through operator[], Find or Get are not tracked.
+ *
+ * @tparam  comp_t  The component type.
+ */
+template <typename comp_t> class ComponentStorage
+{
+    // Data //
+private:
+    static constexpr size_t PageSize{4096}; // sparse entries per page
+    static constexpr uint32_t None{UINT32_MAX};
+
+    std::vector<comp_t> _dense;
+    std::vector<EntityReference> _entities;           // owner of _dense[i]
+    std::vector<std::unique_ptr<uint32_t[]>> _sparse; // entity index -> dense index
+
+    bool _track_changes;
+    std::vector<uint32_t> _versions; // version of the last change of _dense[i]
+    std::vector<uint32_t> _added;    // version of the addition of _dense[i]
+    std::vector<ChangeEvent> _changes;
+    uint32_t _version{0};
+    uint32_t _frame_start{0};    // version at the start of the current frame
+    uint32_t _previous_start{0}; // version at the start of the previous frame
+    uint32_t _dropped{0};        // changes up to this version were dropped
+
+    // Constructors //
+public:
+    explicit ComponentStorage(bool track_changes = false) : _track_changes{track_changes} {}
+
+    // Properties //
+public:
+    size_t Size() const { return _dense.size(); }
+
+    bool Empty() const { return _dense.empty(); }
+
+    comp_t * Data() { return _dense.data(); }
+
+    const comp_t * Data() const { return _dense.data(); }
+
+    /**
+     * @brief   The entities of the components in dense order.
+     */
+    const EntityReference * Entities() const { return _entities.data(); }
+
+    comp_t & operator[](size_t dense_index) { return _dense[dense_index]; }
+
+    const comp_t & operator[](size_t dense_index) const { return _dense[dense_index]; }
+
+    auto begin() { return _dense.begin(); }
+
+    auto end() { return _dense.end(); }
+
+    auto begin() const { return _dense.begin(); }
+
+    auto end() const { return _dense.end(); }
+
+    // Interface //
+public:
+    /**
+     * @brief   Adds the component to the entity, replaces an existing one (also one of a destroyed
+     *          entity that used the same slot).
+     */
+    comp_t & Add(EntityReference e_ref, comp_t component)
+    {
+        if constexpr (std::is_base_of_v<Component, comp_t>) component.Parent = e_ref;
+
+        uint32_t & slot = Slot(e_ref.Index);
+        if (slot != None)
+        {
+            const bool replaced = _entities[slot] == e_ref;
+            if (!replaced) Record(_entities[slot], ChangeType::Removed);
+            _dense[slot] = std::move(component);
+            _entities[slot] = e_ref;
+            _versions[slot] = Record(e_ref, replaced ? ChangeType::Modified : ChangeType::Added);
+            if (!replaced) _added[slot] = _versions[slot];
+            return _dense[slot];
+        }
+
+        slot = static_cast<uint32_t>(_dense.size());
+        _dense.push_back(std::move(component));
+        _entities.push_back(e_ref);
+        _versions.push_back(Record(e_ref, ChangeType::Added));
+        _added.push_back(_versions.back());
+        return _dense.back();
+    }
+
+    /**
+     * @brief   Removes the component of the entity (swap-remove).
+     *
+     * @return  Whether the entity had a component.
+     */
+    bool Remove(EntityReference e_ref)
+    {
+        const uint32_t index = DenseIndex(e_ref);
+        if (index == None) return false;
+
+        const uint32_t last = static_cast<uint32_t>(_dense.size() - 1);
+        if (index != last)
+        {
+            _dense[index] = std::move(_dense[last]);
+            _entities[index] = _entities[last];
+            _versions[index] = _versions[last];
+            _added[index] = _added[last];
+            Slot(_entities[index].Index) = index;
+        }
+        _dense.pop_back();
+        _entities.pop_back();
+        _versions.pop_back();
+        _added.pop_back();
+        Slot(e_ref.Index) = None;
+        Record(e_ref, ChangeType::Removed);
+        return true;
+    }
+
+    bool Has(EntityReference e_ref) const { return DenseIndex(e_ref) != None; }
+
+    /**
+     * @brief   The component of the entity or nullptr.
+     */
+    comp_t * Find(EntityReference e_ref)
+    {
+        const uint32_t index = DenseIndex(e_ref);
+        return index == None ? nullptr : &_dense[index];
+    }
+
+    const comp_t * Find(EntityReference e_ref) const
+    {
+        const uint32_t index = DenseIndex(e_ref);
+        return index == None ? nullptr : &_dense[index];
+    }
+
+    /**
+     * @brief   The component of the entity. Throws if the entity has none.
+     */
+    comp_t & Get(EntityReference e_ref)
+    {
+        comp_t * component = Find(e_ref);
+        if (!component) throw std::runtime_error("Entity has no component of this type.");
+        return *component;
+    }
+
+    /**
+     * @brief   The component of the entity for writing, records a modification. Throws if the
+     *          entity has none.
+     */
+    comp_t & Modify(EntityReference e_ref)
+    {
+        comp_t & component = Get(e_ref);
+        MarkModified(e_ref);
+        return component;
+    }
+
+    /**
+     * @brief   Records a modification of the entity's component.
+     */
+    void MarkModified(EntityReference e_ref)
+    {
+        const uint32_t index = DenseIndex(e_ref);
+        if (index == None) return;
+
+        _versions[index] = Record(e_ref, ChangeType::Modified);
+    }
+
+    /**
+     * @brief   Dense index of the entity's component or None (UINT32_MAX).
+     */
+    uint32_t DenseIndex(EntityReference e_ref) const
+    {
+        const size_t page = e_ref.Index / PageSize;
+        if (page >= _sparse.size() || !_sparse[page]) return None;
+
+        const uint32_t index = _sparse[page][e_ref.Index % PageSize];
+        return index != None && _entities[index] == e_ref ? index : None;
+    }
+
+    // Change Tracking //
+public:
+    /**
+     * @brief   Number of changes so far, pass it to Changes next time.
+     */
+    uint32_t Version() const { return _version; }
+
+    /**
+     * @brief   Calls f(const ChangeEvent &) for every change after version since, in order. An
+     *          addition or modification followed by a later change of the same component is
+     *          skipped, so every component is reported once: as Added at its last version if it was
+     *          added after since, as Modified otherwise. Removals are always reported, also of
+     *          components added after since.
+     *
+     * @return  False if changes after since were already dropped (or tracking is disabled) and f
+     *          was not called, the consumer has to rescan all components then.
+     */
+    template <typename func_t> bool Changes(uint32_t since, func_t && f) const
+    {
+        if (!_track_changes || since < _dropped) return false;
+
+        auto change = std::upper_bound(
+            _changes.begin(), _changes.end(), since,
+            [](uint32_t version, const ChangeEvent & event) { return version < event.Version; });
+        for (; change != _changes.end(); ++change)
+        {
+            if (change->Type == ChangeType::Removed)
+            {
+                f(*change);
+                continue;
+            }
+
+            const uint32_t index = DenseIndex(change->Entity);
+            if (index == None || _versions[index] != change->Version) continue; // superseded
+
+            ChangeEvent latest{*change};
+            if (_added[index] > since) latest.Type = ChangeType::Added;
+            f(latest);
+        }
+        return true;
+    }
+
+    /**
+     * @brief   Drops the changes before the previous frame, consumers running every frame see all
+     *          changes.
+     */
+    void NextFrame()
+    {
+        auto keep = std::upper_bound(
+            _changes.begin(), _changes.end(), _previous_start,
+            [](uint32_t version, const ChangeEvent & event) { return version < event.Version; });
+        _changes.erase(_changes.begin(), keep);
+
+        _dropped = _previous_start;
+        _previous_start = _frame_start;
+        _frame_start = _version;
+    }
+
+private:
+    uint32_t Record(EntityReference e_ref, ChangeType type)
+    {
+        ++_version;
+        if (_track_changes) _changes.push_back(ChangeEvent{e_ref, _version, type});
+        return _version;
+    }
+
+    uint32_t & Slot(uint32_t entity_index)
+    {
+        const size_t page = entity_index / PageSize;
+        if (page >= _sparse.size()) _sparse.resize(page + 1);
+        if (!_sparse[page])
+        {
+            _sparse[page] = std::make_unique<uint32_t[]>(PageSize);
+            std::fill_n(_sparse[page].get(), PageSize, None);
+        }
+        return _sparse[page][entity_index % PageSize];
+    }
+};
+
+} // namespace _implementation
+
+using _implementation::ChangeEvent;
+using _implementation::ChangeType;
+using _implementation::ComponentStorage;
+
+} // namespace My::Engine
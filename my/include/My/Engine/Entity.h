@@ -10,32 +10,78 @@ namespace My::Engine
 namespace _implementation
 {
 
+/**
+ * @brief   List of all component types, expanded into the ComponentType enum and into the storages
+ *          and per-type dispatch of the ComponentManager.
+ */
+#define COMPONENT_TYPES(X)                                                                         \
+    /* NEW COMPONENT --> HERE */                                                                   \
+    X(MeshComponent)                                                                               \
+    X(PointLightComponent)                                                                         \
+    X(SplineAnimationComponent)
+
+#define COMPONENT_TYPE(comp_t) comp_t,
 enum class ComponentType
 {
-    // NEW COMPONENT --> HERE
-    MeshComponent,
-    PointLightComponent
+    COMPONENT_TYPES(COMPONENT_TYPE)
 };
+#undef COMPONENT_TYPE
 
+/**
+ * @brief   Stable handle of a component: an entity has at most one component of each type.
+ */
 struct ComponentReference
 {
-    const size_t Index;
+    const EntityReference Owner;
     const ComponentType Type;
 };
 
-struct Entity
+/**
+ * @brief   Bitmask of the component types an entity has, bit i stands for ComponentType i.
+ */
+using ComponentMask = uint32_t;
+
+constexpr ComponentMask MaskOf(ComponentType type)
 {
-    glm::vec3 Position{0.f, 0.f, 0.f};
-    glm::quat Rotation{1.f, 0.f, 0.f, 0.f};
-    glm::vec3 Scale{1, 1, 1};
+    return ComponentMask(1) << static_cast<uint32_t>(type);
+}
+
+/**
+ * @brief   Bit standing for the entity transforms in access masks (see SystemAccess).
+ */
+constexpr ComponentMask TransformMask{ComponentMask(1) << 31};
+
+#define COUNT(comp_t) +1
+static_assert(0 COMPONENT_TYPES(COUNT) < 31, "ComponentMask has no bit left for a component type.");
+#undef COUNT
 
-    std::vector<ComponentReference> Components;
+/**
+ * @brief   Local transforms (relative to the parent entity) of TransformChunk::Size consecutive
+ *          entity slots as structure of arrays. Every array starts at a cache line, so passes over
+ *          one attribute stream through memory. Passes writing transforms set Dirty, so the world
+ *          matrices are updated (EntityManager::UpdateTransforms).
+ */
+struct alignas(64) TransformChunk
+{
+    static constexpr size_t Size{64};
+
+    glm::vec3 Position[Size];
+    glm::quat Rotation[Size];
+    glm::vec3 Scale[Size];
+    bool Dirty[Size];
 };
 
+static_assert(sizeof(glm::vec3) * TransformChunk::Size % 64 == 0 &&
+                  sizeof(glm::quat) * TransformChunk::Size % 64 == 0,
+              "Transform arrays must fill whole cache lines.");
+
 } // namespace _implementation
 
+using _implementation::ComponentMask;
 using _implementation::ComponentReference;
 using _implementation::ComponentType;
-using _implementation::Entity;
+using _implementation::MaskOf;
+using _implementation::TransformMask;
+using _implementation::TransformChunk;
 
 } // namespace My::Engine
\ No newline at end of file
@@ -1,27 +1,373 @@
 #pragma once
 
 #include "My/Engine/Entity.h"
+#include "My/Engine/SystemAccess.h"
+
+#include "My/Math/GLMHelpers.h"
+#include "My/Utility/AlignedAllocator.h"
 
 namespace My::Engine
 {
 
+namespace _implementation
+{
+class ComponentManager;
+}
+
+/**
+ * @brief   Owns all entities: their local transforms in chunked structure of arrays storage (see
+ *          TransformChunk), their hierarchy, world and normal matrices, component masks and
+ *          generations.
+ *
+ * Slots of destroyed entities are recycled (LIFO free list), so memory stays flat under
+ * spawn/despawn churn. Entities are destroyed through ComponentManager::DestroyEntity, which
+ * releases their components first. References returned by the transform accessors are invalidated
+ * by CreateEntity. Accessors expect valid references (asserted in debug builds).
+ *
+ * The non-const transform accessors mark the entity dirty. UpdateTransforms recomputes the world
+ * matrices of dirty entities and their descendants once per frame, so static scenes cost no matrix
+ * math.
+ */
 class EntityManager
 {
+    friend class _implementation::ComponentManager; // destroys entities
+
 private:
-    std::vector<Entity> _entities;
+    static constexpr uint32_t None{EntityReference::InvalidIndex};
+
+    struct Node
+    {
+        uint32_t Index;
+        uint32_t Parent; // None for roots
+    };
+
+    Utility::AlignedVector<TransformChunk> _chunks;
+    std::vector<ComponentMask> _masks;
+    std::vector<uint32_t> _generations;
+    std::vector<uint32_t> _free; // destroyed slots
+
+    std::vector<EntityReference> _parents;
+    Utility::AlignedVector<glm::mat4> _world;
+    Utility::AlignedVector<glm::mat4> _normal;
+    std::vector<uint8_t> _uniform_scale; // world transform scales uniformly
+    std::vector<uint32_t> _world_frame;  // frame of the last world matrix update
+
+    std::vector<Node> _order; // alive entities in breadth-first order, parents before children
+    bool _order_valid{true};
+    std::vector<uint32_t> _depth, _path, _offsets; // BuildOrder scratch
+    uint32_t _frame{0};
 
 public:
     EntityReference CreateEntity()
     {
-        _entities.push_back(Entity{});
-        return EntityReference{_entities.size() - 1};
+        CheckAccess(TransformMask, true);
+        _order_valid = false;
+
+        if (!_free.empty())
+        {
+            const uint32_t index = _free.back();
+            _free.pop_back();
+            return EntityReference{index, _generations[index]};
+        }
+
+        const uint32_t index = static_cast<uint32_t>(_generations.size());
+        if (index % TransformChunk::Size == 0) _chunks.emplace_back();
+        _masks.push_back(0);
+        _generations.push_back(0);
+        _parents.emplace_back();
+        _world.emplace_back(1.f);
+        _normal.emplace_back(1.f);
+        _uniform_scale.push_back(1);
+        _world_frame.push_back(0);
+        Reset(index);
+        return EntityReference{index, 0};
+    }
+
+    bool Valid(EntityReference e_ref) const
+    {
+        return e_ref.Index < _generations.size() && _generations[e_ref.Index] == e_ref.Generation;
+    }
+
+    /**
+     * @brief   Number of alive entities.
+     */
+    size_t Size() const { return _generations.size() - _free.size(); }
+
+    /**
+     * @brief   Number of slots, i.e. the bound for indices. Slots may hold destroyed entities
+     *          (identity transform, empty mask).
+     */
+    size_t Capacity() const { return _generations.size(); }
+
+    // Transforms //
+public:
+    glm::vec3 & Position(EntityReference e_ref) { return Touch(e_ref).Position[Lane(e_ref)]; }
+
+    glm::quat & Rotation(EntityReference e_ref) { return Touch(e_ref).Rotation[Lane(e_ref)]; }
+
+    glm::vec3 & Scale(EntityReference e_ref) { return Touch(e_ref).Scale[Lane(e_ref)]; }
+
+    const glm::vec3 & Position(EntityReference e_ref) const
+    {
+        return Read(e_ref).Position[Lane(e_ref)];
+    }
+
+    const glm::quat & Rotation(EntityReference e_ref) const
+    {
+        return Read(e_ref).Rotation[Lane(e_ref)];
+    }
+
+    const glm::vec3 & Scale(EntityReference e_ref) const { return Read(e_ref).Scale[Lane(e_ref)]; }
+
+    /**
+     * @brief   Number of transform chunks, chunk i holds the slots [i * Size, (i + 1) * Size).
+     */
+    size_t NumChunks() const { return _chunks.size(); }
+
+    TransformChunk & Chunk(size_t chunk)
+    {
+        CheckAccess(TransformMask, true);
+        return _chunks[chunk];
+    }
+
+    const TransformChunk & Chunk(size_t chunk) const
+    {
+        CheckAccess(TransformMask, false);
+        return _chunks[chunk];
+    }
+
+    // Hierarchy //
+public:
+    /**
+     * @brief   Attaches the entity to the parent, its transform becomes relative to the parent.
+     *          An invalid parent (EntityReference{}) makes the entity a root.
+     */
+    void SetParent(EntityReference e_ref, EntityReference parent)
+    {
+        if (!Valid(e_ref)) throw std::runtime_error("Entity is not valid.");
+        if (parent.Index != None)
+        {
+            if (!Valid(parent)) throw std::runtime_error("Parent entity is not valid.");
+            // links to destroyed parents are cleared lazily (BuildOrder), they end the chain
+            for (EntityReference p = parent; Valid(p); p = _parents[p.Index])
+                if (p == e_ref)
+                    throw std::runtime_error("Entity hierarchy must not contain cycles.");
+        }
+
+        _parents[e_ref.Index] = parent;
+        Touch(e_ref);
+        _order_valid = false;
+    }
+
+    EntityReference Parent(EntityReference e_ref) const
+    {
+        CheckAccess(TransformMask, false);
+        return _parents[e_ref.Index];
+    }
+
+    /**
+     * @brief   Local to world matrix as of the last UpdateTransforms.
+     */
+    const glm::mat4 & WorldMatrix(EntityReference e_ref) const
+    {
+        CheckAccess(TransformMask, false);
+        return _world[e_ref.Index];
+    }
+
+    /**
+     * @brief   Inverse transpose of the world matrix (translation zero) for transforming normals.
+     */
+    const glm::mat4 & NormalMatrix(EntityReference e_ref) const
+    {
+        CheckAccess(TransformMask, false);
+        return _normal[e_ref.Index];
+    }
+
+    /**
+     * @brief   Recomputes the world and normal matrices of all dirty entities and their
+     *          descendants, parents first. Call once per frame after all transform changes.
+     */
+    void UpdateTransforms()
+    {
+        CheckAccess(TransformMask, true);
+        if (!_order_valid) BuildOrder();
+
+        ++_frame;
+        for (const Node & node : _order)
+        {
+            TransformChunk & chunk = Slot(node.Index);
+            const size_t lane = node.Index % TransformChunk::Size;
+            const bool parent_changed = node.Parent != None && _world_frame[node.Parent] == _frame;
+            if (!chunk.Dirty[lane] && !parent_changed) continue;
+
+            const glm::vec3 & scale = chunk.Scale[lane];
+            glm::mat4 world = Math::AffineTransformation(scale, chunk.Rotation[lane],
+                                                         chunk.Position[lane]);
+            bool uniform_scale = scale.x == scale.y && scale.y == scale.z;
+            if (node.Parent != None)
+            {
+                world = _world[node.Parent] * world;
+                uniform_scale = uniform_scale && _uniform_scale[node.Parent];
+            }
+
+            _world[node.Index] = world;
+            _normal[node.Index] = Math::NormalMatrix(world, uniform_scale);
+            _uniform_scale[node.Index] = uniform_scale;
+            _world_frame[node.Index] = _frame;
+            chunk.Dirty[lane] = false;
+        }
+    }
+
+    // Component Masks //
+public:
+    /**
+     * @brief   The component mask of the entity, 0 for an invalid reference. Masks belong to the
+     *          entity table (TransformMask read access), systems adding or removing different
+     *          component types may update the mask of an entity concurrently.
+     */
+    ComponentMask Mask(EntityReference e_ref) const
+    {
+        if (!Valid(e_ref)) return 0;
+
+        CheckAccess(TransformMask, false);
+        auto & mask = const_cast<ComponentMask &>(_masks[e_ref.Index]);
+        return std::atomic_ref<ComponentMask>(mask).load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief   The masks of all slots, indexed by entity index. Not synchronized with systems
+     *          adding or removing components.
+     */
+    const ComponentMask * Masks() const { return _masks.data(); }
+
+    bool HasComponent(EntityReference e_ref, ComponentType type) const
+    {
+        return (Mask(e_ref) & MaskOf(type)) != 0;
+    }
+
+    /**
+     * @brief   Updates the component mask, called by the ComponentManager.
+     */
+    void SetHasComponent(EntityReference e_ref, ComponentType type, bool has)
+    {
+        assert(Valid(e_ref));
+        CheckAccess(TransformMask, false);
+        std::atomic_ref<ComponentMask> mask(_masks[e_ref.Index]);
+        if (has)
+            mask.fetch_or(MaskOf(type), std::memory_order_relaxed);
+        else
+            mask.fetch_and(~MaskOf(type), std::memory_order_relaxed);
+    }
+
+private:
+    /**
+     * @brief   Destroys the entity in O(1) and invalidates all references to it. Does nothing if
+     *          the reference is not valid. Children of the entity become roots. Called by
+     *          ComponentManager::DestroyEntity after removing the components.
+     */
+    void DestroyEntity(EntityReference e_ref)
+    {
+        if (!Valid(e_ref)) return;
+
+        CheckAccess(TransformMask, true);
+        Reset(e_ref.Index);
+        _masks[e_ref.Index] = 0;
+        _parents[e_ref.Index] = EntityReference{};
+        ++_generations[e_ref.Index];
+        _free.push_back(e_ref.Index);
+        _order_valid = false;
+    }
+
+    static size_t Lane(EntityReference e_ref) { return e_ref.Index % TransformChunk::Size; }
+
+    TransformChunk & Slot(uint32_t index) { return _chunks[index / TransformChunk::Size]; }
+
+    const TransformChunk & Slot(uint32_t index) const
+    {
+        return _chunks[index / TransformChunk::Size];
     }
 
-    auto begin() { return _entities.begin(); }
+    const TransformChunk & Read(EntityReference e_ref) const
+    {
+        assert(Valid(e_ref));
+        CheckAccess(TransformMask, false);
+        return Slot(e_ref.Index);
+    }
 
-    auto end() { return _entities.end(); }
+    TransformChunk & Touch(EntityReference e_ref)
+    {
+        assert(Valid(e_ref));
+        CheckAccess(TransformMask, true);
+        TransformChunk & chunk = Slot(e_ref.Index);
+        // jobs may write different channels of the same entity concurrently
+        std::atomic_ref<bool>(chunk.Dirty[Lane(e_ref)]).store(true, std::memory_order_relaxed);
+        return chunk;
+    }
 
-    Entity & operator[](size_t index) { return _entities[index]; }
+    void Reset(uint32_t index)
+    {
+        TransformChunk & chunk = Slot(index);
+        const size_t lane = index % TransformChunk::Size;
+        chunk.Position[lane] = glm::vec3(0.f, 0.f, 0.f);
+        chunk.Rotation[lane] = glm::quat(1.f, 0.f, 0.f, 0.f);
+        chunk.Scale[lane] = glm::vec3(1.f, 1.f, 1.f);
+        chunk.Dirty[lane] = true;
+    }
+
+    /**
+     * @brief   Sorts the alive entities by depth (counting sort), which is a breadth-first order.
+     *          Entities whose parent was destroyed become roots.
+     */
+    void BuildOrder()
+    {
+        const size_t n = _generations.size();
+        std::vector<uint32_t> & depth = _depth;
+        depth.assign(n, 0);
+        for (const uint32_t index : _free) depth[index] = None;
+
+        for (uint32_t index = 0; index < n; ++index)
+        {
+            if (_parents[index].Index != None && !Valid(_parents[index]))
+            {
+                _parents[index] = EntityReference{};
+                Slot(index).Dirty[index % TransformChunk::Size] = true;
+            }
+        }
+
+        // depth + 1 of each alive entity, 0 = not computed yet
+        std::vector<uint32_t> & path = _path;
+        path.clear();
+        uint32_t max_depth = 0;
+        for (uint32_t index = 0; index < n; ++index)
+        {
+            if (depth[index] != 0) continue;
+
+            uint32_t top = index;
+            for (; depth[top] == 0 && _parents[top].Index != None; top = _parents[top].Index)
+                path.push_back(top);
+            if (depth[top] == 0) depth[top] = 1;
+
+            for (uint32_t d = depth[top]; !path.empty(); path.pop_back())
+                depth[path.back()] = ++d;
+            max_depth = std::max(max_depth, depth[index]);
+        }
+
+        std::vector<uint32_t> & offsets = _offsets;
+        offsets.assign(max_depth + 1, 0);
+        for (uint32_t index = 0; index < n; ++index)
+            if (depth[index] != None) ++offsets[depth[index]];
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        _order.resize(Size());
+        for (uint32_t index = 0; index < n; ++index)
+        {
+            if (depth[index] == None) continue;
+
+            const uint32_t parent = _parents[index].Index;
+            _order[offsets[depth[index] - 1]++] = Node{index, parent};
+        }
+        _order_valid = true;
+    }
 };
 
 } // namespace My::Engine
\ No newline at end of file
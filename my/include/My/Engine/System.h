@@ -2,14 +2,42 @@
 
 #include "My/Engine/ComponentManager.h"
 #include "My/Engine/EntityManager.h"
+#include "My/Engine/SystemAccess.h"
+
+#include "My/Utility/JobSystem.h"
 
 namespace My::Engine
 {
 
+/**
+ * @brief   What a system gets for one frame update.
+ */
+struct SystemContext
+{
+    float DeltaTime; // seconds
+    EntityManager & Entities;
+    ComponentManager & Components;
+    Utility::JobSystem & Jobs;
+};
+
+/**
+ * @brief   Base of all systems. Systems run by the SystemScheduler declare the data they access
+ *          (Access) and implement Update, systems without conflicting access run in parallel.
+ */
 class System
 {
+public:
+    bool Enabled{true}; // disabled systems are skipped by the scheduler
+
 public:
     virtual ~System() = default;
+
+    /**
+     * @brief   The data read and written by Update, may change between frames.
+     */
+    virtual SystemAccess Access() const { return SystemAccess{}; }
+
+    virtual void Update(const SystemContext &) {}
 };
 
 } // namespace My::Engine
\ No newline at end of file
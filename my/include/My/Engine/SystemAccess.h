@@ -0,0 +1,128 @@
+#pragma once
+
+#include "pch.h"
+
+#include "My/Engine/Entity.h"
+
+#include "My/Utility/JobSystem.h"
+
+namespace My::Engine
+{
+
+namespace _implementation
+{
+
+/**
+ * @brief   Data a system reads and writes, as masks of component types (MaskOf) and TransformMask.
+ *          Writing implies reading.
+ */
+struct SystemAccess
+{
+    ComponentMask Read{0};
+    ComponentMask Write{0};
+    bool MainThread{false}; // must run on the main thread
+
+    bool Conflicts(const SystemAccess & other) const
+    {
+        return (Write & (other.Read | other.Write)) != 0 || (other.Write & Read) != 0;
+    }
+};
+
+#ifdef _DEBUG
+/**
+ * @brief   Debug build bookkeeping of the data held by the running systems.
+ *
+ * The scheduler acquires the declared access of a system while it runs and reports systems running
+ * concurrently with conflicting declarations. It also tags the system's jobs with its SystemAccess
+ * (see Utility::JobSystem::Tag), including the jobs the system pushes. While systems run, every
+ * access through the EntityManager and ComponentManager is checked against the declaration of the
+ * system the calling job belongs to, so a system touching data it did not declare, or code outside
+ * of the systems touching any data, is reported instead of silently racing. Violations happen
+ * inside of jobs, which must not throw, so the first one is recorded (the access proceeds) and the
+ * scheduler throws it once the systems finished (TakeViolation).
+ */
+class AccessTracker
+{
+private:
+    std::mutex _mutex;
+    std::atomic<uint32_t> _running{0};
+    std::atomic<ComponentMask> _read{0}; // held by at least one running system
+    std::atomic<ComponentMask> _write{0};
+    uint32_t _readers[32]{};
+    std::atomic<const char *> _violation{nullptr}; // first one since TakeViolation
+
+public:
+    static AccessTracker & Instance()
+    {
+        static AccessTracker tracker;
+        return tracker;
+    }
+
+    void Acquire(const SystemAccess & access)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const ComponentMask read = access.Read & ~access.Write;
+        if ((access.Write & (_read | _write)) || (read & _write))
+            Report("Systems with conflicting access run concurrently.");
+
+        for (uint32_t bit = 0; bit < 32; ++bit)
+            if (read & (ComponentMask(1) << bit)) ++_readers[bit];
+        _read |= read;
+        _write |= access.Write;
+        ++_running;
+    }
+
+    void Release(const SystemAccess & access)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const ComponentMask read = access.Read & ~access.Write;
+        for (uint32_t bit = 0; bit < 32; ++bit)
+            if ((read & (ComponentMask(1) << bit)) && --_readers[bit] == 0)
+                _read &= ~(ComponentMask(1) << bit);
+        _write &= ~access.Write;
+        --_running;
+    }
+
+    void Check(ComponentMask data, bool write)
+    {
+        if (_running == 0) return; // no systems running, e.g. setup code on the main thread
+
+        const auto * access = static_cast<const SystemAccess *>(Utility::JobSystem::Tag());
+        if (!access) return Report("Data is accessed outside of the running systems.");
+
+        const ComponentMask held = write ? access->Write : (access->Read | access->Write);
+        if ((data & held) != data)
+            Report(write ? "A system writes data it did not declare."
+                         : "A system reads data it did not declare.");
+    }
+
+    /**
+     * @brief   The first violation since the last call or nullptr.
+     */
+    const char * TakeViolation() { return _violation.exchange(nullptr); }
+
+private:
+    void Report(const char * violation)
+    {
+        const char * none = nullptr;
+        _violation.compare_exchange_strong(none, violation);
+    }
+};
+#endif
+
+/**
+ * @brief   Checks an access to data against the running systems (debug builds only).
+ */
+inline void CheckAccess([[maybe_unused]] ComponentMask data, [[maybe_unused]] bool write)
+{
+#ifdef _DEBUG
+    AccessTracker::Instance().Check(data, write);
+#endif
+}
+
+} // namespace _implementation
+
+using _implementation::CheckAccess;
+using _implementation::SystemAccess;
+
+} // namespace My::Engine
\ No newline at end of file
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "pch.h"
+
+#include "My/Engine/System.h"
+
+namespace My::Engine
+{
+
+namespace _implementation
+{
+
+/**
+ * @brief   Runs the registered systems once per frame on the job system, in parallel where their
+ *          declared accesses do not conflict.
+ *
+ * Every frame the enabled systems and their declarations are collected into a dependency graph: a
+ * system depends on every earlier registered system it conflicts with (one writes data the other
+ * reads or writes). Systems start as soon as their dependencies finished, so the result equals
+ * running them in registration order. Main thread systems run on the thread calling Run.
+ *
+ * In debug builds (_DEBUG) conflicting systems running at the same time and accesses to undeclared
+ * data through the EntityManager and ComponentManager are recorded, and Run throws the first one as
+ * std::logic_error after all systems finished.
+ */
+class SystemScheduler
+{
+    // Data //
+private:
+    struct Node
+    {
+        System * Target;
+        SystemAccess Access;
+        std::vector<uint32_t> Successors;
+        uint32_t Dependencies;
+    };
+
+    std::vector<System *> _systems;
+
+    std::vector<Node> _nodes; // the first _num_nodes are used, the others keep their storage
+    uint32_t _num_nodes{0};
+    std::unique_ptr<std::atomic<uint32_t>[]> _pending; // unfinished dependencies per node
+    size_t _pending_size{0};
+    std::atomic<size_t> _remaining{0};
+
+    std::mutex _main_mutex;
+    std::vector<uint32_t> _main_ready; // main thread systems ready to run
+
+    const SystemContext * _context{nullptr};
+
+    // Interface //
+public:
+    /**
+     * @brief   Registers the system, the registration order breaks ties between conflicting
+     *          systems.
+     */
+    void Add(System & system) { _systems.push_back(&system); }
+
+    void Remove(System & system)
+    {
+        _systems.erase(std::remove(_systems.begin(), _systems.end(), &system), _systems.end());
+    }
+
+    /**
+     * @brief   Updates all enabled systems and returns when they finished. Call on the main thread,
+     *          it runs jobs while waiting. Systems must not throw. Throws std::logic_error for
+     *          access violations in debug builds.
+     */
+    void Run(const SystemContext & context)
+    {
+        BuildGraph();
+        if (_num_nodes == 0) return;
+
+        _context = &context;
+        _remaining = _num_nodes;
+        for (uint32_t node = 0; node < _num_nodes; ++node)
+            if (_nodes[node].Dependencies == 0) Schedule(node);
+
+        while (_remaining.load() != 0)
+            if (!RunMainThreadSystem() && !context.Jobs.RunOne()) std::this_thread::yield();
+
+        _context = nullptr;
+#ifdef _DEBUG
+        if (const char * violation = AccessTracker::Instance().TakeViolation())
+            throw std::logic_error(violation);
+#endif
+    }
+
+private:
+    void BuildGraph()
+    {
+        _num_nodes = 0;
+        for (System * system : _systems)
+        {
+            if (!system->Enabled) continue;
+
+            if (_num_nodes == _nodes.size()) _nodes.emplace_back();
+            Node & node = _nodes[_num_nodes++];
+            node.Target = system;
+            node.Access = system->Access();
+            node.Successors.clear();
+            node.Dependencies = 0;
+        }
+
+        for (uint32_t later = 0; later < _num_nodes; ++later)
+        {
+            for (uint32_t earlier = 0; earlier < later; ++earlier)
+            {
+                if (!_nodes[earlier].Access.Conflicts(_nodes[later].Access)) continue;
+
+                _nodes[earlier].Successors.push_back(later);
+                ++_nodes[later].Dependencies;
+            }
+        }
+
+        if (_pending_size < _num_nodes)
+        {
+            _pending = std::make_unique<std::atomic<uint32_t>[]>(_num_nodes);
+            _pending_size = _num_nodes;
+        }
+        for (size_t node = 0; node < _num_nodes; ++node)
+            _pending[node].store(_nodes[node].Dependencies);
+    }
+
+    void Schedule(uint32_t node)
+    {
+        if (_nodes[node].Access.MainThread)
+        {
+            std::lock_guard<std::mutex> lock(_main_mutex);
+            _main_ready.push_back(node);
+        }
+        else
+            _context->Jobs.Push(Utility::Job{&RunNode, this, node, 0});
+    }
+
+    bool RunMainThreadSystem()
+    {
+        uint32_t node;
+        {
+            std::lock_guard<std::mutex> lock(_main_mutex);
+            if (_main_ready.empty()) return false;
+            node = _main_ready.back();
+            _main_ready.pop_back();
+        }
+        Execute(node);
+        return true;
+    }
+
+    static void RunNode(void * scheduler, size_t node, size_t)
+    {
+        static_cast<SystemScheduler *>(scheduler)->Execute(static_cast<uint32_t>(node));
+    }
+
+    void Execute(uint32_t node)
+    {
+        const Node & current = _nodes[node];
+#ifdef _DEBUG
+        AccessTracker::Instance().Acquire(current.Access);
+        const void * tag = Utility::JobSystem::Tag();
+        Utility::JobSystem::SetTag(&current.Access); // inherited by the jobs of the system
+        current.Target->Update(*_context);
+        Utility::JobSystem::SetTag(tag);
+        AccessTracker::Instance().Release(current.Access);
+#else
+        current.Target->Update(*_context);
+#endif
+
+        for (const uint32_t successor : current.Successors)
+            if (_pending[successor].fetch_sub(1) == 1) Schedule(successor);
+        _remaining.fetch_sub(1);
+    }
+};
+
+} // namespace _implementation
+
+using _implementation::SystemScheduler;
+
+} // namespace My::Engine
\ No newline at end of file
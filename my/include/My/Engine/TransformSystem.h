@@ -0,0 +1,29 @@
+#pragma once
+
+#include "pch.h"
+
+#include "My/Engine/System.h"
+
+namespace My::Engine
+{
+
+namespace _implementation
+{
+
+/**
+ * @brief   Updates the world and normal matrices of the entities (EntityManager::UpdateTransforms),
+ *          register it after the systems moving entities.
+ */
+class TransformSystem : public System
+{
+public:
+    SystemAccess Access() const override { return SystemAccess{0, TransformMask}; }
+
+    void Update(const SystemContext & context) override { context.Entities.UpdateTransforms(); }
+};
+
+} // namespace _implementation
+
+using _implementation::TransformSystem;
+
+} // namespace My::Engine
\ No newline at end of file
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "pch.h"
+
+#include "My/Engine/ComponentManager.h"
+#include "My/Engine/ComponentStorage.h"
+
+#include "My/Utility/JobSystem.h"
+
+namespace My::Engine
+{
+
+namespace _implementation
+{
+
+/**
+ * @brief   Query over all entities having every one of the component types comp_t.
+ *
+ * The smallest storage drives the loop, the other components are looked up by entity in O(1). The
+ * view only holds pointers to the storages, iterating allocates nothing. Components of const
+ * qualified types are passed as const references. The storages must not gain or lose components
+ * of the viewed types while iterating.
+ *
+ * @code
+ * View<const MeshComponent, PointLightComponent> view{component_manager};
+ * view.Each([&](EntityReference entity, const MeshComponent & mesh, PointLightComponent & light) {
+ *     light.Intensity = float(mesh.Vertices.size());
+ * });
+ * @endcode
+ *
+ * Transforms are not components, every entity has one in the EntityManager.
+ *
+ * @tparam  comp_t  The (optionally const) component types.
+ */
+template <typename... comp_t> class View
+{
+    static_assert(sizeof...(comp_t) > 0, "A view needs at least one component type.");
+
+    template <typename T>
+    using storage_t = std::conditional_t<std::is_const_v<T>,
+                                         const ComponentStorage<std::remove_const_t<T>>,
+                                         ComponentStorage<T>>;
+
+    // Data //
+private:
+    std::tuple<storage_t<comp_t> *...> _storages;
+    size_t _driver{0}; // index of the smallest storage
+
+    // Constructors //
+public:
+    explicit View(ComponentManager & manager) : View(StorageFor<comp_t>(manager)...) {}
+
+    /**
+     * @brief   View over arbitrary storages, e.g. to join components with system owned data.
+     */
+    explicit View(storage_t<comp_t> &... storages) : _storages{&storages...}
+    {
+        const size_t sizes[] = {storages.Size()...};
+        _driver = std::min_element(std::begin(sizes), std::end(sizes)) - std::begin(sizes);
+    }
+
+    // Interface //
+public:
+    /**
+     * @brief   Upper bound of the number of matching entities (size of the smallest storage).
+     */
+    size_t Size() const
+    {
+        return std::apply([&](const auto *... storages) {
+            const size_t sizes[] = {storages->Size()...};
+            return sizes[_driver];
+        }, _storages);
+    }
+
+    /**
+     * @brief   Calls f(EntityReference, comp_t &...) for every matching entity.
+     */
+    template <typename func_t> void Each(func_t && f) { Range(0, Size(), f); }
+
+    /**
+     * @brief   Calls f for every matching entity concurrently on the job system. The smallest
+     *          storage is split into contiguous blocks of at least grain components, f must be safe
+     *          to call for different entities at the same time.
+     */
+    template <typename func_t>
+    void ParallelEach(Utility::JobSystem & jobs, func_t && f, size_t grain = 256)
+    {
+        jobs.ParallelFor(0, Size(), [&](size_t begin, size_t end) { Range(begin, end, f); }, grain);
+    }
+
+    /**
+     * @brief   Calls f for the matching entities among the dense indices [begin, end) of the
+     *          smallest storage, e.g. for custom chunking.
+     */
+    template <typename func_t> void Range(size_t begin, size_t end, func_t & f)
+    {
+        Dispatch(begin, end, f, std::index_sequence_for<comp_t...>{});
+    }
+
+private:
+    template <typename T> static storage_t<T> & StorageFor(ComponentManager & manager)
+    {
+        if constexpr (std::is_const_v<T>)
+            return std::as_const(manager).template Storage<std::remove_const_t<T>>(); // read only
+        else
+            return manager.template Storage<T>();
+    }
+
+    template <typename func_t, size_t... D>
+    void Dispatch(size_t begin, size_t end, func_t & f, std::index_sequence<D...> seq)
+    {
+        ((_driver == D ? Visit<D>(begin, end, f, seq) : void()), ...);
+    }
+
+    template <size_t D, typename func_t, size_t... I>
+    void Visit(size_t begin, size_t end, func_t & f, std::index_sequence<I...>)
+    {
+        const EntityReference * entities = std::get<D>(_storages)->Entities();
+        for (size_t i = begin; i < end; ++i)
+        {
+            const EntityReference entity = entities[i];
+            const auto components = std::make_tuple(Lookup<I, D>(entity, i)...);
+            if ((std::get<I>(components) && ...)) f(entity, *std::get<I>(components)...);
+        }
+    }
+
+    template <size_t I, size_t D> auto * Lookup(EntityReference entity, size_t dense_index)
+    {
+        auto & storage = *std::get<I>(_storages);
+        if constexpr (I == D)
+            return &storage[dense_index];
+        else
+            return storage.Find(entity);
+    }
+};
+
+} // namespace _implementation
+
+using _implementation::View;
+
+} // namespace My::Engine
\ No newline at end of file
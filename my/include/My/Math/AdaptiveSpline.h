@@ -0,0 +1,208 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "Math/Intervall.h"
+#include "Math/QuadraticSpline.h"
+#include "Math/SplineFitter.h"
+#include "Math/SplineSegment.h"
+
+namespace My::Math
+{
+
+/**
+ * @brief   Builds a non-uniform @ref QuadraticSpline with as few knots as possible such that the
+ *          error against a reference stays below a tolerance.
+ *
+ * The construction starts with a single segment and refines: the spline is fitted to the reference
+ * samples (@ref SplineFitter) and every segment whose maximum error exceeds the tolerance is split
+ * in the middle. Once the bound is met, interior knots are removed again (knots next to the
+ * segments with the smallest error first) whenever the refitted spline still meets the bound.
+ *
+ * The error is measured at the reference samples only. A reference function is sampled
+ * equidistantly, choose the sample count according to the finest expected feature. Note that
+ * QuadraticSpline has a vanishing derivative at its first knot, which forces small segments at the
+ * start if the reference does not.
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ *
+ * @ingroup Math
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+template <typename value_t> class AdaptiveSpline
+{
+    // Data
+private:
+    value_t _tolerance;
+    size_t _max_knots;
+    value_t _smoothing;
+    value_t _error{0};
+
+    std::vector<value_t> _sample_x, _sample_y;
+
+    // Constructors
+public:
+    /**
+     * @brief   Create new instance.
+     *
+     * @param   tolerance   Maximum absolute error.
+     * @param   max_knots   Upper limit for the number of knots.
+     * @param   smoothing   Smoothing of the fit (see SplineFitter), keeps segments without samples
+     *                      solvable.
+     */
+    AdaptiveSpline(value_t tolerance, size_t max_knots = 1024, value_t smoothing = value_t(1e-8))
+        : _tolerance{tolerance}, _max_knots{std::max<size_t>(max_knots, 2)}, _smoothing{smoothing}
+    {}
+
+    // Properties
+public:
+    value_t tolerance() const noexcept { return _tolerance; }
+
+    /**
+     * @brief   Maximum error of the last built spline at the reference samples. Exceeds
+     *          tolerance() if the knot limit was hit.
+     */
+    value_t error() const noexcept { return _error; }
+
+    // Methods
+public:
+    /**
+     * @brief   Approximates the function f within the intervall.
+     *
+     * @param   f           Reference function value_t(value_t).
+     * @param   intervall   The intervall.
+     * @param   num_samples Number of equidistant reference samples.
+     */
+    template <typename func_t>
+    std::shared_ptr<QuadraticSpline<value_t>> build(func_t && f, Intervall<value_t> intervall,
+                                                    size_t num_samples = 4096)
+    {
+        num_samples = std::max<size_t>(num_samples, 2);
+        std::vector<value_t> x(num_samples), y(num_samples);
+        const value_t step{(intervall._end - intervall._start) / value_t(num_samples - 1)};
+        for (size_t i = 0; i < num_samples; ++i)
+        {
+            x[i] = i + 1 < num_samples ? intervall._start + value_t(i) * step : intervall._end;
+            y[i] = f(x[i]);
+        }
+        return build(x.data(), y.data(), num_samples);
+    }
+
+    /**
+     * @brief   Approximates a sample set. The intervall is the range of the sample positions.
+     *
+     * @param   x   Sample positions (any order).
+     * @param   y   Sample values.
+     * @param   n   Number of samples (at least 2 distinct positions).
+     */
+    std::shared_ptr<QuadraticSpline<value_t>> build(const value_t * x, const value_t * y, size_t n)
+    {
+        _sample_x.assign(x, x + n);
+        _sample_y.assign(y, y + n);
+        const auto [min, max] = std::minmax_element(_sample_x.begin(), _sample_x.end());
+        if (n < 2 || !(*min < *max))
+            throw std::runtime_error("AdaptiveSpline: at least two distinct samples required.");
+
+        std::vector<value_t> knots{*min, *max}, errors;
+        auto spline = fit(knots, errors);
+
+        // refine
+        while (_error > _tolerance && knots.size() < _max_knots)
+        {
+            std::vector<value_t> refined{knots.front()};
+            for (size_t j = 0; j + 1 < knots.size(); ++j)
+            {
+                if (errors[j] > _tolerance && refined.size() + 1 < _max_knots)
+                    refined.push_back((knots[j] + knots[j + 1]) / 2);
+                refined.push_back(knots[j + 1]);
+            }
+            if (refined.size() == knots.size()) break;
+
+            knots = std::move(refined);
+            spline = fit(knots, errors);
+        }
+        if (_error > _tolerance) return spline;
+
+        // coarsen, starting with the knots whose neighbouring segments have the smallest error
+        std::vector<size_t> order(knots.size() - 2);
+        std::iota(order.begin(), order.end(), size_t(1));
+        std::sort(order.begin(), order.end(), [&errors](size_t a, size_t b) {
+            return std::max(errors[a - 1], errors[a]) < std::max(errors[b - 1], errors[b]);
+        });
+
+        std::vector<bool> removed(knots.size(), false);
+        std::vector<value_t> candidate, candidate_errors;
+        for (size_t k : order)
+        {
+            removed[k] = true;
+            candidate.clear();
+            for (size_t i = 0; i < knots.size(); ++i)
+                if (!removed[i]) candidate.push_back(knots[i]);
+
+            auto coarse = fit(candidate, candidate_errors);
+            if (_error <= _tolerance)
+                spline = std::move(coarse);
+            else
+                removed[k] = false;
+        }
+
+        // restore the error of the result
+        _error = maxError(*spline, nullptr);
+        return spline;
+    }
+
+private:
+    /**
+     * @brief   Fits a spline with the given knots to the samples and computes the maximum error of
+     *          every segment. Sets _error, singular fits result in an infinite error.
+     */
+    std::shared_ptr<QuadraticSpline<value_t>> fit(const std::vector<value_t> & knots,
+                                                  std::vector<value_t> & errors)
+    {
+        auto spline = std::make_shared<QuadraticSpline<value_t>>(
+            knots, std::vector<value_t>(knots.size(), value_t(0)));
+
+        errors.assign(knots.size() - 1, value_t(0));
+        try
+        {
+            SplineFitter<value_t> fitter(*spline, _smoothing);
+            fitter.add(_sample_x.data(), _sample_y.data(), _sample_x.size());
+            fitter.apply(*spline);
+        }
+        catch (const std::runtime_error &)
+        {
+            std::fill(errors.begin(), errors.end(), std::numeric_limits<value_t>::infinity());
+            _error = std::numeric_limits<value_t>::infinity();
+            return spline;
+        }
+
+        _error = maxError(*spline, &errors);
+        return spline;
+    }
+
+    value_t maxError(QuadraticSpline<value_t> & spline, std::vector<value_t> * errors) const
+    {
+        using std::abs;
+
+        value_t result{0};
+        for (size_t i = 0; i < _sample_x.size(); ++i)
+        {
+            const value_t e{abs(spline.compute(_sample_x[i]) - _sample_y[i])};
+            result = std::max(result, e);
+            if (errors)
+            {
+                const size_t j{findSegment(spline.knotXData(), spline.numKnots(), _sample_x[i])};
+                (*errors)[j] = std::max((*errors)[j], e);
+            }
+        }
+        return result;
+    }
+};
+
+} // namespace My::Math
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "Math/Intervall.h"
+#include "Math/Spline.h"
+#include "Utility/AlignedAllocator.h"
+
+namespace My::Math
+{
+
+/**
+ * @brief   Converts a float to IEEE 754 half precision (round to nearest even).
+ *
+ * @ingroup Math
+ */
+inline uint16_t toHalf(float value)
+{
+    uint32_t f;
+    std::memcpy(&f, &value, sizeof(f));
+
+    const uint32_t sign{(f >> 16) & 0x8000u};
+    const uint32_t f_exp{(f >> 23) & 0xffu};
+    uint32_t mant{f & 0x7fffffu};
+
+    if (f_exp == 0xffu) return uint16_t(sign | 0x7c00u | (mant ? 0x200u : 0u)); // inf, nan
+
+    const int32_t exp{int32_t(f_exp) - 127 + 15};
+    if (exp >= 31) return uint16_t(sign | 0x7c00u); // overflow
+
+    if (exp <= 0) // subnormal
+    {
+        if (exp < -10) return uint16_t(sign);
+        mant |= 0x800000u;
+        const uint32_t shift{uint32_t(14 - exp)};
+        uint32_t half{mant >> shift};
+        const uint32_t rem{mant & ((1u << shift) - 1)}, mid{1u << (shift - 1)};
+        if (rem > mid || (rem == mid && (half & 1u))) ++half;
+        return uint16_t(sign | half);
+    }
+
+    uint32_t half{sign | (uint32_t(exp) << 10) | (mant >> 13)};
+    const uint32_t rem{mant & 0x1fffu};
+    if (rem > 0x1000u || (rem == 0x1000u && (half & 1u))) ++half; // carry into exponent is fine
+    return uint16_t(half);
+}
+
+/**
+ * @brief   Lookup table of a generated spline for real-time evaluation.
+ *
+ * The spline is sampled equidistantly and evaluated by linear interpolation in O(1) without
+ * branches. The sample distance h is derived from the requested maximum absolute error: the
+ * generated splines are C1 and piecewise quadratic (a x^2 + b x + c), so the interpolation error
+ * is bounded by max|a| * h^2 / 4.
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ *
+ * @ingroup Math
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+template <typename value_t> class BakedSpline
+{
+    // Data
+private:
+    Utility::AlignedVector<value_t> _table;
+    Intervall<value_t> _intervall;
+    value_t _inv_step, _last;
+    value_t _error_bound;
+
+    // Constructors
+public:
+    /**
+     * @brief   Bakes the spline. Execute Spline::generate before.
+     *
+     * @param   spline          The spline to sample.
+     * @param   max_error       Requested maximum absolute error.
+     * @param   max_samples     Upper limit for the table size. If the limit is hit the achieved
+     *                          bound is reported by errorBound().
+     */
+    BakedSpline(Spline<value_t> & spline, value_t max_error,
+                size_t max_samples = size_t(1) << 20)
+        : _intervall{spline.intervall()}
+    {
+        using std::abs;
+        using std::ceil;
+        using std::sqrt;
+
+        value_t max_a{0};
+        const value_t * p = spline.polynomData();
+        for (size_t i = 0; i + 1 < spline.numKnots(); ++i) max_a = std::max(max_a, abs(p[3 * i]));
+
+        const value_t length{_intervall._end - _intervall._start};
+        size_t num_segments{1};
+        if (max_a > 0)
+        {
+            const value_t h{2 * sqrt(max_error / max_a)};
+            num_segments = size_t(ceil(length / h));
+        }
+        num_segments = std::clamp<size_t>(num_segments, 1, std::max<size_t>(max_samples, 2) - 1);
+
+        const value_t step{length / value_t(num_segments)};
+        _inv_step = value_t(num_segments) / length;
+        _last = value_t(num_segments);
+        _error_bound = max_a * step * step / 4;
+
+        _table.resize(num_segments + 2); // one padding sample for the clamped end
+        for (size_t i = 0; i <= num_segments; ++i)
+            _table[i] = spline.compute(_intervall._start + value_t(i) * step);
+        _table[num_segments + 1] = _table[num_segments];
+    }
+
+    // Properties
+public:
+    Intervall<value_t> intervall() const noexcept { return _intervall; }
+
+    /**
+     * @brief   Number of samples within the intervall.
+     */
+    size_t numSamples() const noexcept { return _table.size() - 1; }
+
+    const value_t * data() const noexcept { return _table.data(); }
+
+    /**
+     * @brief   Guaranteed maximum absolute error of compute() within the intervall.
+     */
+    value_t errorBound() const noexcept { return _error_bound; }
+
+    /**
+     * @brief   Memory used by the table in bytes.
+     */
+    size_t memoryBytes() const noexcept { return _table.size() * sizeof(value_t); }
+
+    // Methods
+public:
+    /**
+     * @brief   Evaluates the table at x. Values outside of the intervall are clamped.
+     */
+    value_t compute(value_t x) const noexcept
+    {
+        value_t t{(x - _intervall._start) * _inv_step};
+        t = std::min(std::max(t, value_t(0)), _last);
+        const size_t i{size_t(t)};
+        const value_t f{t - value_t(i)};
+        return _table[i] + f * (_table[i + 1] - _table[i]);
+    }
+
+    value_t operator()(value_t x) const noexcept { return compute(x); }
+
+    /**
+     * @brief   Evaluates the table at n positions.
+     */
+    void compute(const value_t * x, value_t * out, size_t n) const noexcept
+    {
+        for (size_t j = 0; j < n; ++j) out[j] = compute(x[j]);
+    }
+
+    /**
+     * @brief   Exports the samples as float16 (e.g. for a R16_FLOAT texture). The rounding adds a
+     *          relative error of at most 2^-11.
+     */
+    std::vector<uint16_t> toHalf() const
+    {
+        std::vector<uint16_t> result(numSamples());
+        for (size_t i = 0; i < result.size(); ++i) result[i] = Math::toHalf(float(_table[i]));
+        return result;
+    }
+};
+
+} // namespace My::Math
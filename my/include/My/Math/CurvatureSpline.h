@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "Math/Intervall.h"
+#include "Math/Parallel.h"
 #include "Math/QuadraticSpline.h"
 
 namespace My::Math
@@ -13,8 +14,8 @@ namespace My::Math
 /**
  * @brief   Class describes a Curvature Spline which is a QuadraticSpline.
  * 
- * <b>Note</b> It does not have any kind of knots. So you cannot use the regular
- * SplineSimulationArgument class for the SimplexAlgorithm.
+ * <b>Note</b> It does not have any kind of knots. Its free parameters (e.g. for a
+ * SplineArgument) are the curvatures.
  * 
  * @tparam  value_t     The floating point type to operate on.
  * 
@@ -52,15 +53,36 @@ public:
 
     value_t curvature(size_t a) const { return _a[a]; }
 
+    /**
+     * @brief   The value at the start of the intervall.
+     */
+    value_t y0() const { return _y_0; }
+
+    /**
+     * @brief   The value at the end of the intervall.
+     */
+    value_t yn() const { return _y_n; }
+
+    std::vector<value_t> & parameterStorage() override { return _a; }
+
+    size_t numParameters() const override { return _a.size(); }
+
     // Methods
 private:
-    value_t calpha()
+    value_t calpha(bool parallel = false)
     {
-        value_t A = 0;
-        for (size_t i = 0; i < _a.size() - 1; ++i) A += _a[i];
-
-        value_t B = 0;
-        for (size_t i = 0; i < _a.size() - 1; ++i) B += _a[i] * (_a.size() - 2 - i);
+        value_t A = 0, B = 0;
+        if (parallel)
+        {
+            A = Parallel::reduce<value_t>(_a.size() - 1, [this](size_t i) { return _a[i]; });
+            B = Parallel::reduce<value_t>(
+                _a.size() - 1, [this](size_t i) { return _a[i] * (_a.size() - 2 - i); });
+        }
+        else
+        {
+            for (size_t i = 0; i < _a.size() - 1; ++i) A += _a[i];
+            for (size_t i = 0; i < _a.size() - 1; ++i) B += _a[i] * (_a.size() - 2 - i);
+        }
 
         return (_y_n - _y_0) /
                ((this->_delta * this->_delta) * (_a[_a.size() - 1] + 3 * A + 2 * B));
@@ -86,6 +108,12 @@ public:
 
     void generate() override
     {
+        if (_a.size() >= QuadraticSpline<value_t>::ParallelThreshold)
+        {
+            generateParallel();
+            return;
+        }
+
         value_t alpha{calpha()}, delta{this->_delta};
         auto & polynom = this->_polynom;
 
@@ -107,9 +135,9 @@ public:
         }
 
         // Move into their corresponding area
-        for (size_t i = 1; i < _a.size(); ++i)
+        for (size_t i = 0; i < _a.size(); ++i)
         {
-            value_t p = (delta * i) - this->intervall()._start;
+            value_t p = this->intervall()._start + delta * i;
             // a is correct
             // c
             polynom[3 * i + 2] += polynom[3 * i] * p * p - polynom[3 * i + 1] * p;
@@ -118,6 +146,45 @@ public:
         }
     }
 
+    /**
+     * @brief   Same as generate() but computes the b and c chains as parallel prefix scans. Used by
+     *          generate() for large splines.
+     */
+    void generateParallel()
+    {
+        value_t alpha{calpha(true)}, delta{this->_delta};
+        auto & polynom = this->_polynom;
+        const size_t n = _a.size(), blocks = Parallel::numBlocks(n, 4096);
+
+        // b[i] = b[i - 1] + 2 alpha a[i - 1] delta
+        std::vector<value_t> b(n); // b[0] = 0
+        Parallel::forBlocks(n, blocks, 1, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = std::max<size_t>(begin, 1); i < end; ++i)
+                b[i] = 2 * alpha * _a[i - 1] * delta;
+        });
+        Parallel::inclusiveScan(b.data(), n);
+
+        // c[i] = c[i - 1] + alpha a[i - 1] delta^2 + b[i - 1] delta
+        std::vector<value_t> c(n);
+        c[0] = _y_0;
+        Parallel::forBlocks(n, blocks, 1, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = std::max<size_t>(begin, 1); i < end; ++i)
+                c[i] = alpha * _a[i - 1] * delta * delta + b[i - 1] * delta;
+        });
+        Parallel::inclusiveScan(c.data(), n);
+
+        // Move into their corresponding area
+        Parallel::forBlocks(n, blocks, 1, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                value_t a{alpha * _a[i]}, p{this->intervall()._start + delta * i};
+                polynom[3 * i] = a;
+                polynom[3 * i + 1] = b[i] - 2 * a * p;
+                polynom[3 * i + 2] = c[i] + a * p * p - b[i] * p;
+            }
+        });
+    }
+
     value_t compute(value_t value) override
     {
         if (this->_uniform)
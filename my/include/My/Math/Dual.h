@@ -0,0 +1,233 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+namespace My::Math
+{
+
+/**
+ * @brief   Forward mode automatic differentiation number v + sum_k d_k e_k with e_k e_l = 0.
+ *
+ * Propagates the value together with N tangents (partial derivatives with respect to N seeded
+ * inputs), so one evaluation of a function template instantiated with Dual yields its value and
+ * gradient. Comparisons only consider the value, conversions to arithmetic types (e.g. segment
+ * indices) are explicit and drop the tangents.
+ *
+ * The math functions are found by argument dependent lookup, generic code calls them unqualified
+ * after e.g. using std::sqrt.
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ * @tparam  N           Number of tangents.
+ *
+ * @ingroup Math
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+template <typename value_t, size_t N = 1> class Dual
+{
+    // Data
+private:
+    value_t _value{0};
+    std::array<value_t, N> _d{};
+
+    // Constructors
+public:
+    constexpr Dual() = default;
+
+    /**
+     * @brief   A constant (all tangents zero).
+     */
+    template <typename scalar_t, std::enable_if_t<std::is_arithmetic_v<scalar_t>, int> = 0>
+    constexpr Dual(scalar_t value) : _value{value_t(value)}
+    {}
+
+    /**
+     * @brief   The k-th input variable, i.e. the tangent e_k.
+     */
+    static constexpr Dual variable(value_t value, size_t k)
+    {
+        Dual result{value};
+        result._d[k] = value_t(1);
+        return result;
+    }
+
+    // Properties
+public:
+    constexpr value_t value() const noexcept { return _value; }
+
+    constexpr value_t d(size_t k) const noexcept { return _d[k]; }
+
+    constexpr value_t & d(size_t k) noexcept { return _d[k]; }
+
+    constexpr const std::array<value_t, N> & gradient() const noexcept { return _d; }
+
+    template <typename scalar_t, std::enable_if_t<std::is_arithmetic_v<scalar_t>, int> = 0>
+    explicit constexpr operator scalar_t() const
+    {
+        return scalar_t(_value);
+    }
+
+    // Methods
+private:
+    /**
+     * @brief   Returns f(v) with the tangents scaled by the derivative df (chain rule).
+     */
+    constexpr Dual chain(value_t f, value_t df) const
+    {
+        Dual result{f};
+        for (size_t k = 0; k < N; ++k) result._d[k] = df * _d[k];
+        return result;
+    }
+
+public:
+    constexpr Dual operator-() const { return chain(-_value, value_t(-1)); }
+
+    constexpr Dual operator+() const { return *this; }
+
+    constexpr Dual & operator+=(const Dual & o)
+    {
+        _value += o._value;
+        for (size_t k = 0; k < N; ++k) _d[k] += o._d[k];
+        return *this;
+    }
+
+    constexpr Dual & operator-=(const Dual & o)
+    {
+        _value -= o._value;
+        for (size_t k = 0; k < N; ++k) _d[k] -= o._d[k];
+        return *this;
+    }
+
+    constexpr Dual & operator*=(const Dual & o)
+    {
+        for (size_t k = 0; k < N; ++k) _d[k] = _d[k] * o._value + _value * o._d[k];
+        _value *= o._value;
+        return *this;
+    }
+
+    constexpr Dual & operator/=(const Dual & o)
+    {
+        const value_t inv{value_t(1) / o._value};
+        _value *= inv;
+        for (size_t k = 0; k < N; ++k) _d[k] = (_d[k] - _value * o._d[k]) * inv;
+        return *this;
+    }
+
+    friend constexpr Dual operator+(Dual a, const Dual & b) { return a += b; }
+
+    friend constexpr Dual operator-(Dual a, const Dual & b) { return a -= b; }
+
+    friend constexpr Dual operator*(Dual a, const Dual & b) { return a *= b; }
+
+    friend constexpr Dual operator/(Dual a, const Dual & b) { return a /= b; }
+
+    friend constexpr bool operator==(const Dual & a, const Dual & b)
+    {
+        return a._value == b._value;
+    }
+
+    friend constexpr bool operator!=(const Dual & a, const Dual & b)
+    {
+        return a._value != b._value;
+    }
+
+    friend constexpr bool operator<(const Dual & a, const Dual & b) { return a._value < b._value; }
+
+    friend constexpr bool operator>(const Dual & a, const Dual & b) { return a._value > b._value; }
+
+    friend constexpr bool operator<=(const Dual & a, const Dual & b)
+    {
+        return a._value <= b._value;
+    }
+
+    friend constexpr bool operator>=(const Dual & a, const Dual & b)
+    {
+        return a._value >= b._value;
+    }
+
+    friend Dual sqrt(const Dual & x)
+    {
+        const value_t s{std::sqrt(x._value)};
+        return x.chain(s, s > value_t(0) ? value_t(0.5) / s : value_t(0));
+    }
+
+    friend Dual abs(const Dual & x) { return x._value < value_t(0) ? -x : x; }
+
+    friend Dual exp(const Dual & x)
+    {
+        const value_t e{std::exp(x._value)};
+        return x.chain(e, e);
+    }
+
+    friend Dual log(const Dual & x) { return x.chain(std::log(x._value), value_t(1) / x._value); }
+
+    friend Dual sin(const Dual & x) { return x.chain(std::sin(x._value), std::cos(x._value)); }
+
+    friend Dual cos(const Dual & x) { return x.chain(std::cos(x._value), -std::sin(x._value)); }
+
+    friend Dual pow(const Dual & x, value_t p)
+    {
+        return x.chain(std::pow(x._value, p), p * std::pow(x._value, p - 1));
+    }
+
+    friend Dual ceil(const Dual & x) { return Dual{std::ceil(x._value)}; }
+
+    friend Dual floor(const Dual & x) { return Dual{std::floor(x._value)}; }
+
+    friend std::ostream & operator<<(std::ostream & os, const Dual & x)
+    {
+        os << x._value << "[";
+        for (size_t k = 0; k < N; ++k) os << (k ? " " : "") << x._d[k];
+        return os << "]";
+    }
+};
+
+/**
+ * @brief   Gradient of a function of n inputs by forward mode automatic differentiation.
+ *
+ * f is evaluated ceil(n / N) times, each pass seeds the tangents of N consecutive inputs, instead
+ * of the n + 1 evaluations of finite differences. The result is exact up to rounding.
+ *
+ * @code
+ * auto energy = [&](const std::vector<Dual<double, 8>> & y) {
+ *     QuadraticSpline<Dual<double, 8>> spline{x, y};
+ *     spline.generate();
+ *     return spline.integrateDerivativeSquared(a, b);
+ * };
+ * const double value{gradient<8>(energy, y.data(), y.size(), g.data())};
+ * @endcode
+ *
+ * @tparam  N           Number of tangents per pass.
+ * @param   f           Callable taking const std::vector<Dual<value_t, N>> & returning a Dual.
+ * @param   x           The point to differentiate at.
+ * @param   n           Number of inputs.
+ * @param   out         Receives the n partial derivatives.
+ *
+ * @return  f(x)
+ */
+template <size_t N, typename value_t, typename function_t>
+value_t gradient(function_t && f, const value_t * x, size_t n, value_t * out)
+{
+    std::vector<Dual<value_t, N>> arguments(x, x + n);
+    const std::vector<Dual<value_t, N>> & seeded{arguments};
+    value_t value{0};
+    for (size_t begin = 0; begin < n || begin == 0; begin += N)
+    {
+        const size_t end{std::min(begin + N, n)};
+        for (size_t i = begin; i < end; ++i)
+            arguments[i] = Dual<value_t, N>::variable(x[i], i - begin);
+
+        const Dual<value_t, N> result{f(seeded)};
+        value = result.value();
+        for (size_t i = begin; i < end; ++i) out[i] = result.d(i - begin);
+
+        for (size_t i = begin; i < end; ++i) arguments[i] = Dual<value_t, N>{x[i]};
+    }
+    return value;
+}
+
+} // namespace My::Math
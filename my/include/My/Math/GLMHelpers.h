@@ -5,14 +5,14 @@
 namespace My::Math
 {
 
-glm::quat RollPitchYaw(double yaw, double pitch, double roll) 
+inline glm::quat RollPitchYaw(float yaw, float pitch, float roll)
 {
-    float cy = cos(yaw * 0.5f);
-    float sy = sin(yaw * 0.5f);
-    float cp = cos(pitch * 0.5f);
-    float sp = sin(pitch * 0.5f);
-    float cr = cos(roll * 0.5f);
-    float sr = sin(roll * 0.5f);
+    float cy = std::cos(yaw * 0.5f);
+    float sy = std::sin(yaw * 0.5f);
+    float cp = std::cos(pitch * 0.5f);
+    float sp = std::sin(pitch * 0.5f);
+    float cr = std::cos(roll * 0.5f);
+    float sr = std::sin(roll * 0.5f);
 
     glm::quat q;
     q.w = cr * cp * cy + sr * sp * sy;
@@ -23,4 +23,36 @@ glm::quat RollPitchYaw(double yaw, double pitch, double roll)
     return q;
 }
 
+/**
+ * @brief   The matrix T * R * S, i.e. scales, then rotates by the unit quaternion and translates.
+ */
+inline glm::mat4 AffineTransformation(const glm::vec3 & scale, const glm::quat & rotation,
+                                      const glm::vec3 & translation)
+{
+    const float x = rotation.x, y = rotation.y, z = rotation.z, w = rotation.w;
+
+    return glm::mat4{
+        glm::vec4{1.f - 2.f * (y * y + z * z), 2.f * (x * y + w * z), 2.f * (x * z - w * y), 0.f} *
+            scale.x,
+        glm::vec4{2.f * (x * y - w * z), 1.f - 2.f * (x * x + z * z), 2.f * (y * z + w * x), 0.f} *
+            scale.y,
+        glm::vec4{2.f * (x * z + w * y), 2.f * (y * z - w * x), 1.f - 2.f * (x * x + y * y), 0.f} *
+            scale.z,
+        glm::vec4{translation.x, translation.y, translation.z, 1.f}};
+}
+
+/**
+ * @brief   Inverse transpose of the linear part of an affine transformation (translation zero).
+ *
+ * @param   uniform_scale   Whether the linear part is s * R with a rotation R. Then the inverse
+ *                          transpose is R / s = M / s^2 and no inverse is computed.
+ */
+inline glm::mat4 NormalMatrix(const glm::mat4 & transformation, bool uniform_scale)
+{
+    const glm::mat3 m{transformation};
+    if (uniform_scale) return glm::mat4{m * (1.f / glm::dot(m[0], m[0]))};
+
+    return glm::mat4{glm::transpose(glm::inverse(m))};
+}
+
 }
\ No newline at end of file
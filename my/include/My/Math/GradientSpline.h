@@ -7,7 +7,7 @@
 #include "Math/Intervall.h"
 #include "Math/QuadraticSpline.h"
 
-namespace My
+namespace My::Math
 {
 
 /**
@@ -52,6 +52,21 @@ public:
         _last = o._last;
     }
 
+    // Properties
+public:
+    /**
+     * @brief   Whether the last segment is computed such that the spline ends in y_n.
+     */
+    bool fixedEnd() const noexcept { return _last; }
+
+    /**
+     * @brief   The free parameters are the gradients, i.e. all y-knots except y_0 (and y_n).
+     */
+    size_t parameterOffset() const override { return 1; }
+
+    size_t numParameters() const override { return this->_knot_y.size() - (_last ? 2 : 1); }
+
+    // Methods
 public:
     void generate() override
     {
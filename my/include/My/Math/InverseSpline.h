@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "Math/Intervall.h"
+#include "Math/Parallel.h"
+#include "Math/QuadraticSpline.h"
+#include "Utility/AlignedAllocator.h"
+
+namespace My::Math
+{
+
+/**
+ * @brief   Inverse of a generated monotone @ref QuadraticSpline (also GradientSpline and
+ *          CurvatureSpline), i.e. solves spline(x) = y for x.
+ *
+ * The derivative of a quadratic segment is linear, so a segment is monotone iff the derivatives at
+ * both ends do not have opposite signs. For a monotone spline the knot values are sorted, hence the
+ * segment containing y is found by binary search and the quadratic is solved in closed form with
+ * the cancellation free root t = 2 (y - c) / (b + sqrt(b^2 + 4 a (y - c))).
+ *
+ * Decreasing splines are stored negated, so all queries run the same increasing code path. The
+ * batched compute() is written branch-free (fixed step binary search, conditional moves) on
+ * aligned structure-of-arrays data for auto-vectorization.
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ *
+ * @ingroup Math
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+template <typename value_t> class InverseSpline
+{
+    // Data
+private:
+    Utility::AlignedVector<value_t> _y;         // sign * knot values (ascending)
+    Utility::AlignedVector<value_t> _x, _h;     // segment start and width
+    Utility::AlignedVector<value_t> _a, _b, _c; // sign * local coefficients
+    value_t _sign{1};
+
+    // Constructors
+public:
+    /**
+     * @brief   Create the inverse. Throws if the spline is not monotone.
+     *
+     * @param   spline  The generated spline.
+     */
+    InverseSpline(const QuadraticSpline<value_t> & spline)
+    {
+        const size_t segments{spline.numKnots() - 1};
+        const value_t *x{spline.knotXData()}, *p{spline.polynomData()};
+
+        _y.resize(segments + 1);
+        _x.resize(segments);
+        _h.resize(segments);
+        _a.resize(segments);
+        _b.resize(segments);
+        _c.resize(segments);
+        for (size_t i = 0; i < segments; ++i)
+        {
+            _x[i] = x[i];
+            _h[i] = x[i + 1] - x[i];
+            _a[i] = p[3 * i];
+            _b[i] = 2 * p[3 * i] * x[i] + p[3 * i + 1];
+            _c[i] = (p[3 * i] * x[i] + p[3 * i + 1]) * x[i] + p[3 * i + 2];
+            _y[i] = _c[i];
+        }
+        _y[segments] = (_a[segments - 1] * _h[segments - 1] + _b[segments - 1]) * _h[segments - 1] +
+                       _c[segments - 1];
+
+        const int direction{monotone(spline)};
+        if (!direction) throw std::runtime_error("InverseSpline: spline is not monotone.");
+        _sign = value_t(direction);
+        for (size_t i = 0; i < segments; ++i)
+        {
+            _a[i] *= _sign;
+            _b[i] *= _sign;
+            _c[i] *= _sign;
+            _y[i] *= _sign;
+        }
+        _y[segments] *= _sign;
+
+        // rounding may break the order of (nearly) flat neighbours
+        for (size_t i = 1; i <= segments; ++i) _y[i] = std::max(_y[i], _y[i - 1]);
+    }
+
+    // Properties
+public:
+    /**
+     * @brief   Checks whether the generated spline is monotone.
+     *
+     * @return  1 if non-decreasing, -1 if non-increasing, 0 otherwise. Constant splines count as
+     *          non-decreasing.
+     */
+    static int monotone(const QuadraticSpline<value_t> & spline)
+    {
+        using std::abs;
+
+        const size_t segments{spline.numKnots() - 1};
+        const value_t *x{spline.knotXData()}, *p{spline.polynomData()};
+
+        // the generated start derivative is only zero up to rounding
+        value_t scale{0};
+        for (size_t i = 0; i < segments; ++i)
+            scale = std::max({scale, abs(2 * p[3 * i] * x[i] + p[3 * i + 1]),
+                              abs(2 * p[3 * i] * x[i + 1] + p[3 * i + 1])});
+        const value_t tolerance{1024 * std::numeric_limits<value_t>::epsilon() * scale};
+
+        bool increasing{true}, decreasing{true};
+        for (size_t i = 0; i < segments; ++i)
+        {
+            const value_t d0{2 * p[3 * i] * x[i] + p[3 * i + 1]},
+                d1{2 * p[3 * i] * x[i + 1] + p[3 * i + 1]};
+            increasing = increasing && d0 >= -tolerance && d1 >= -tolerance;
+            decreasing = decreasing && d0 <= tolerance && d1 <= tolerance;
+        }
+        return increasing ? 1 : (decreasing ? -1 : 0);
+    }
+
+    bool increasing() const noexcept { return _sign > 0; }
+
+    /**
+     * @brief   The value range of the spline, i.e. the domain of the inverse.
+     */
+    Intervall<value_t> range() const noexcept
+    {
+        const value_t first{_sign * _y.front()}, last{_sign * _y.back()};
+        return {std::min(first, last), std::max(first, last)};
+    }
+
+    // Methods
+public:
+    /**
+     * @brief   Returns x with spline(x) = y. Values outside of range() map to the respective end.
+     */
+    value_t compute(value_t y) const { return solve(segment(_sign * y), _sign * y); }
+
+    value_t operator()(value_t y) const { return compute(y); }
+
+    /**
+     * @brief   Batched version of compute(), segment-parallel for large n.
+     *
+     * @param   y       Input values.
+     * @param   out     Output positions (may alias y).
+     * @param   n       Number of values.
+     */
+    void compute(const value_t * y, value_t * out, size_t n) const
+    {
+        auto block = [&](size_t begin, size_t end, size_t) {
+            constexpr size_t Chunk{64};
+            size_t index[Chunk];
+            value_t v[Chunk];
+            for (size_t j = begin; j < end; j += Chunk)
+            {
+                const size_t m{std::min(Chunk, end - j)};
+                for (size_t k = 0; k < m; ++k) v[k] = _sign * y[j + k];
+                for (size_t k = 0; k < m; ++k) index[k] = segment(v[k]);
+                for (size_t k = 0; k < m; ++k) out[j + k] = solve(index[k], v[k]);
+            }
+        };
+        Parallel::forBlocks(n, Parallel::numBlocks(n, 16384), 1, block);
+    }
+
+private:
+    /**
+     * @brief   Largest segment i with y_i <= y, branch-free with a fixed number of steps.
+     */
+    size_t segment(value_t y) const
+    {
+        const value_t * values{_y.data()};
+        size_t base{0}, length{_x.size()};
+        while (length > 1)
+        {
+            const size_t half{length / 2};
+            base = values[base + half] <= y ? base + half : base;
+            length -= half;
+        }
+        return base;
+    }
+
+    value_t solve(size_t i, value_t y) const
+    {
+        using std::sqrt;
+
+        const value_t a{_a[i]}, b{_b[i]}, r{y - _c[i]};
+        const value_t discriminant{std::max(b * b + 4 * a * r, value_t(0))};
+        const value_t denominator{b + sqrt(discriminant)};
+        value_t t{denominator > value_t(0) ? 2 * r / denominator : value_t(0)};
+        t = std::min(std::max(t, value_t(0)), _h[i]);
+        return _x[i] + t;
+    }
+};
+
+} // namespace My::Math
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Math/QuadraticSpline.h"
+#include "Math/SplineSegment.h"
+#include "Utility/AlignedAllocator.h"
+
+namespace My::Math
+{
+
+/**
+ * @brief   Structure-of-arrays representation of a quadratic spline for bulk evaluation.
+ *
+ * The coefficients are stored in separate cache line aligned arrays a, b and c and are relative
+ * to the segment start, i.e. segment i evaluates to (a_i * t + b_i) * t + c_i with t = x - x_i.
+ * This needs fewer operations than the global form of @ref Spline::polynomData and does not lose
+ * precision for intervalls far from the origin.
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ *
+ * @ingroup Math
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+template <typename value_t> class LocalQuadraticSpline
+{
+    // Data
+private:
+    Utility::AlignedVector<value_t> _x;         // knots (num_segments + 1)
+    Utility::AlignedVector<value_t> _a, _b, _c; // local coefficients per segment
+    bool _uniform{false};
+    value_t _inv_delta{0};
+
+    // Constructors
+public:
+    /**
+     * @brief   Converts a generated spline. Execute QuadraticSpline::generate before.
+     *
+     * @param   spline  The spline whose polynomData() is converted.
+     */
+    LocalQuadraticSpline(const QuadraticSpline<value_t> & spline)
+        : _x(spline.X().begin(), spline.X().end()), _uniform{spline.uniform()}
+    {
+        resize();
+        const value_t * p = spline.polynomData();
+        for (size_t i = 0; i < numSegments(); ++i)
+        {
+            const value_t x_i{_x[i]};
+            _a[i] = p[3 * i];
+            _b[i] = 2 * p[3 * i] * x_i + p[3 * i + 1];
+            _c[i] = (p[3 * i] * x_i + p[3 * i + 1]) * x_i + p[3 * i + 2];
+        }
+    }
+
+    /**
+     * @brief   Interpolates the knots directly in local coordinates (same conditions as
+     *          QuadraticSpline::generate, i.e. vanishing derivative at the first knot).
+     *
+     * @param   knot_x  x-Knot Values (sorted).
+     * @param   knot_y  y-Knot Values.
+     */
+    LocalQuadraticSpline(const std::vector<value_t> & knot_x, const std::vector<value_t> & knot_y)
+        : _x(knot_x.begin(), knot_x.end())
+    {
+        resize();
+
+        value_t w_prev{0}; // derivative at the segment start
+        for (size_t i = 0; i < numSegments(); ++i)
+        {
+            const value_t h{_x[i + 1] - _x[i]};
+            const value_t w{2 * (knot_y[i + 1] - knot_y[i]) / h - w_prev};
+            _a[i] = (w - w_prev) / (2 * h);
+            _b[i] = w_prev;
+            _c[i] = knot_y[i];
+            w_prev = w;
+        }
+    }
+
+private:
+    void resize()
+    {
+        _a.resize(_x.size() - 1);
+        _b.resize(_x.size() - 1);
+        _c.resize(_x.size() - 1);
+        if (_uniform) _inv_delta = value_t(numSegments()) / (_x.back() - _x.front());
+    }
+
+    // Properties
+public:
+    size_t numSegments() const noexcept { return _a.size(); }
+
+    size_t numKnots() const noexcept { return _x.size(); }
+
+    bool uniform() const noexcept { return _uniform; }
+
+    const value_t * knotXData() const noexcept { return _x.data(); }
+
+    const value_t * aData() const noexcept { return _a.data(); }
+
+    const value_t * bData() const noexcept { return _b.data(); }
+
+    const value_t * cData() const noexcept { return _c.data(); }
+
+    // Methods
+public:
+    /**
+     * @brief   Returns the segment containing x (clamped to the first/last segment).
+     */
+    size_t segment(value_t x) const
+    {
+        return _uniform ? findUniformSegment(_x[0], _inv_delta, numSegments(), x)
+                        : findSegment(_x.data(), _x.size(), x);
+    }
+
+    value_t compute(value_t x) const
+    {
+        const size_t i{segment(x)};
+        const value_t t{x - _x[i]};
+        return (_a[i] * t + _b[i]) * t + _c[i];
+    }
+
+    value_t derivative(value_t x) const
+    {
+        const size_t i{segment(x)};
+        return 2 * _a[i] * (x - _x[i]) + _b[i];
+    }
+
+    /**
+     * @brief   Evaluates the spline at n positions.
+     *
+     * @param   x       Input positions.
+     * @param   out     Output values (may alias x).
+     * @param   n       Number of positions.
+     */
+    void compute(const value_t * x, value_t * out, size_t n) const
+    {
+        const value_t *a{_a.data()}, *b{_b.data()}, *c{_c.data()}, *k{_x.data()};
+        if (_uniform)
+        {
+            const value_t start{_x[0]}, inv_delta{_inv_delta};
+            const size_t segments{numSegments()};
+            for (size_t j = 0; j < n; ++j)
+            {
+                const size_t i{findUniformSegment(start, inv_delta, segments, x[j])};
+                const value_t t{x[j] - k[i]};
+                out[j] = (a[i] * t + b[i]) * t + c[i];
+            }
+        }
+        else
+        {
+            for (size_t j = 0; j < n; ++j)
+            {
+                const size_t i{findSegment(k, _x.size(), x[j])};
+                const value_t t{x[j] - k[i]};
+                out[j] = (a[i] * t + b[i]) * t + c[i];
+            }
+        }
+    }
+
+    /**
+     * @brief   Converts the coefficients back into the global layout of Spline::polynomData.
+     *
+     * @return  Coefficients structured as: p0[0] p0[1] p0[2], p1[0] ...
+     */
+    std::vector<value_t> polynom() const
+    {
+        std::vector<value_t> p(3 * numSegments());
+        for (size_t i = 0; i < numSegments(); ++i)
+        {
+            const value_t x_i{_x[i]};
+            p[3 * i] = _a[i];
+            p[3 * i + 1] = _b[i] - 2 * _a[i] * x_i;
+            p[3 * i + 2] = (_a[i] * x_i - _b[i]) * x_i + _c[i];
+        }
+        return p;
+    }
+
+    /**
+     * @brief   Creates a (non-uniform) QuadraticSpline with the same coefficients for consumers of
+     *          the global layout.
+     */
+    std::shared_ptr<QuadraticSpline<value_t>> toQuadraticSpline() const
+    {
+        std::vector<value_t> knot_y(numKnots());
+        for (size_t i = 0; i < numSegments(); ++i) knot_y[i] = _c[i];
+        const size_t last{numSegments() - 1};
+        const value_t h{_x[last + 1] - _x[last]};
+        knot_y[last + 1] = (_a[last] * h + _b[last]) * h + _c[last];
+
+        return std::make_shared<QuadraticSpline<value_t>>(
+            std::vector<value_t>(_x.begin(), _x.end()), knot_y, polynom());
+    }
+};
+
+} // namespace My::Math
@@ -1,14 +1,27 @@
 #pragma once
 
+#include "Math/AdaptiveSpline.h"
+#include "Math/BakedSpline.h"
 #include "Math/CurvatureSpline.h"
+#include "Math/Dual.h"
 #include "Math/GradientSpline.h"
 #include "Math/Spline.h"
 #include "Math/Intervall.h"
+#include "Math/InverseSpline.h"
+#include "Math/LocalQuadraticSpline.h"
+#include "Math/Parallel.h"
 #include "Math/QuadraticSpline.h"
 #include "Math/SimplexFunction.h"
 #include "Math/SimplexFunctionArgument.h"
 #include "Math/SimplexPair.h"
 #include "Math/SimplexSolver.h"
+#include "Math/SplineArgument.h"
+#include "Math/SplineBatch.h"
+#include "Math/SplineFitter.h"
+#include "Math/SplineRangeTree.h"
+#include "Math/SplineSerialization.h"
+#include "Math/StaticSpline.h"
+#include "Math/VectorSpline.h"
 
 /**
  * @brief    Module containing various math classes.
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace My::Math::Parallel
+{
+
+/**
+ * @brief   Returns the number of worker threads used by the parallel math kernels.
+ *
+ * @ingroup Math
+ */
+inline size_t numWorkers() { return std::max<size_t>(1, std::thread::hardware_concurrency()); }
+
+/**
+ * @brief   Computes into how many blocks a range of n elements is split.
+ *
+ * @param   n           Number of elements.
+ * @param   min_block   Minimum number of elements per block.
+ *
+ * @ingroup Math
+ */
+inline size_t numBlocks(size_t n, size_t min_block)
+{
+    return std::clamp<size_t>(n / std::max<size_t>(1, min_block), 1, numWorkers());
+}
+
+/**
+ * @brief   Splits [0, n) into num_blocks contiguous blocks and calls f(begin, end, block) for each
+ *          block concurrently. Block borders are multiples of align.
+ *
+ * @param   n           Number of elements.
+ * @param   num_blocks  Number of blocks (see numBlocks).
+ * @param   align       Alignment of the block borders.
+ * @param   f           The block kernel.
+ *
+ * @ingroup Math
+ */
+template <typename func_t> void forBlocks(size_t n, size_t num_blocks, size_t align, func_t && f)
+{
+    size_t block_size = (n + num_blocks - 1) / num_blocks;
+    block_size = ((block_size + align - 1) / align) * align;
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_blocks);
+    for (size_t b = 1; b < num_blocks; ++b)
+    {
+        size_t begin = std::min(n, b * block_size), end = std::min(n, begin + block_size);
+        threads.emplace_back([&f, begin, end, b]() { f(begin, end, b); });
+    }
+    f(0, std::min(n, block_size), size_t(0)); // calling thread works on the first block
+
+    for (auto & t : threads) t.join();
+}
+
+/**
+ * @brief   Parallel in-place inclusive scan with stride, i.e. solves the linear recurrence
+ *          data[i] += data[i - stride] for all i >= stride.
+ *
+ * The range is split into blocks which are scanned locally, the block carries are propagated
+ * serially and finally added to each block. The result differs from the serial recurrence only by
+ * floating point reassociation.
+ *
+ * @param   data        The data to scan in place.
+ * @param   n           Number of elements.
+ * @param   stride      Distance of the recurrence (1 = regular prefix sum).
+ * @param   min_block   Minimum number of elements per block.
+ *
+ * @ingroup Math
+ */
+template <typename value_t>
+void inclusiveScan(value_t * data, size_t n, size_t stride = 1, size_t min_block = 4096)
+{
+    size_t blocks = numBlocks(n, std::max(min_block, stride));
+    if (blocks == 1)
+    {
+        for (size_t i = stride; i < n; ++i) data[i] += data[i - stride];
+        return;
+    }
+
+    std::vector<value_t> carry(blocks * stride, value_t(0));
+
+    // 1st pass: local scan per block
+    forBlocks(n, blocks, stride, [&](size_t begin, size_t end, size_t b) {
+        for (size_t i = begin + stride; i < end; ++i) data[i] += data[i - stride];
+        for (size_t i = std::max(begin, end - std::min(end, stride)); i < end; ++i)
+            carry[b * stride + i % stride] = data[i];
+    });
+
+    // 2nd pass: exclusive scan over the block carries
+    std::vector<value_t> offset(blocks * stride, value_t(0));
+    for (size_t b = 1; b < blocks; ++b)
+        for (size_t k = 0; k < stride; ++k)
+            offset[b * stride + k] = offset[(b - 1) * stride + k] + carry[(b - 1) * stride + k];
+
+    // 3rd pass: add the carries
+    forBlocks(n, blocks, stride, [&](size_t begin, size_t end, size_t b) {
+        if (b == 0) return;
+        for (size_t k = 0; k < stride; ++k)
+        {
+            const value_t o = offset[b * stride + k];
+            for (size_t i = begin + k; i < end; i += stride) data[i] += o;
+        }
+    });
+}
+
+/**
+ * @brief   Parallel sum of f(i) for i in [0, n).
+ *
+ * @ingroup Math
+ */
+template <typename value_t, typename func_t>
+value_t reduce(size_t n, func_t && f, size_t min_block = 4096)
+{
+    size_t blocks = numBlocks(n, min_block);
+    std::vector<value_t> partial(blocks, value_t(0));
+    forBlocks(n, blocks, 1, [&](size_t begin, size_t end, size_t b) {
+        value_t s(0);
+        for (size_t i = begin; i < end; ++i) s += f(i);
+        partial[b] = s;
+    });
+    return std::accumulate(partial.begin(), partial.end(), value_t(0));
+}
+
+} // namespace My::Math::Parallel
@@ -1,12 +1,15 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <memory>
 #include <vector>
 
 #include "Math/Intervall.h"
+#include "Math/Parallel.h"
 #include "Math/Spline.h"
-#include "Utility/Utility.h"
+#include "Math/SplineSegment.h"
 
 namespace My::Math
 {
@@ -23,6 +26,13 @@ namespace My::Math
 template <typename value_t> class QuadraticSpline : public Spline<value_t>
 {
     // Data
+public:
+    /**
+     * @brief   Number of knots from which on generate() solves the recurrences as parallel
+     *          prefix scans.
+     */
+    static constexpr size_t ParallelThreshold{size_t(1) << 16};
+
 protected:
     bool _uniform{true};
 
@@ -48,7 +58,7 @@ public:
      * @param   knot_y   y-Knot Values
      */
     QuadraticSpline(std::initializer_list<value_t> knot_x, std::initializer_list<value_t> knot_y)
-        : Spline<value_t>(knot_x.size(), Intervall<value_t>{*knot_x.begin(), *knot_x.end()}),
+        : Spline<value_t>(knot_x.size(), Intervall<value_t>{*knot_x.begin(), *(knot_x.end() - 1)}),
           _uniform{false}
     {
         this->_polynom =
@@ -64,7 +74,7 @@ public:
      * @param   knot_y   y-Knot Values
      */
     QuadraticSpline(std::vector<value_t> knot_x, std::vector<value_t> knot_y)
-        : Spline<value_t>(knot_x.size(), Intervall<value_t>{*knot_x.begin(), *knot_x.end()}),
+        : Spline<value_t>(knot_x.size(), Intervall<value_t>{*knot_x.begin(), *(knot_x.end() - 1)}),
           _uniform{false}
     {
         this->_polynom =
@@ -82,7 +92,8 @@ public:
      */
     QuadraticSpline(std::initializer_list<value_t> knot_x, std::initializer_list<value_t> knot_y,
                     std::initializer_list<value_t> polynom)
-        : Spline<value_t>(polynom.size() / 3, Intervall<value_t>{0, 0}), _uniform{false}
+        : Spline<value_t>(knot_x.size(), Intervall<value_t>{*knot_x.begin(), *(knot_x.end() - 1)}),
+          _uniform{false}
     {
         this->_polynom = std::vector<value_t>(polynom.size());
         std::copy(knot_x.begin(), knot_x.end(), this->_knot_x.begin());
@@ -99,7 +110,8 @@ public:
      */
     QuadraticSpline(std::vector<value_t> knot_x, std::vector<value_t> knot_y,
                     std::vector<value_t> polynom)
-        : Spline<value_t>(polynom.size() / 3, Intervall<value_t>{0, 0}), _uniform{false}
+        : Spline<value_t>(knot_x.size(), Intervall<value_t>{*knot_x.begin(), *(knot_x.end() - 1)}),
+          _uniform{false}
     {
         this->_polynom = std::vector<value_t>(polynom.size());
         std::copy(knot_x.begin(), knot_x.end(), this->_knot_x.begin());
@@ -107,7 +119,15 @@ public:
         std::copy(polynom.begin(), polynom.end(), this->_polynom.begin());
     }
 
-    QuadraticSpline(const QuadraticSpline<value_t> & o) : Spline<value_t>(o) {}
+    QuadraticSpline(const QuadraticSpline<value_t> & o) : Spline<value_t>(o), _uniform{o._uniform}
+    {}
+
+    // Properties
+public:
+    /**
+     * @brief   Whether the knots are equally distributed in x-direction.
+     */
+    bool uniform() const noexcept { return _uniform; }
 
     // METHODS
 private:
@@ -134,13 +154,13 @@ private:
     {
         if ((i * 3) < this->_polynom.size())
         {
-            return this->_polynom[i * 3] * x + //
+            return 2 * this->_polynom[i * 3] * x + //
                    this->_polynom[i * 3 + 1];
         }
         else
         {
-            return this->_polynom[(this->_knot_x.size() - 1) * 3] * x + //
-                   this->_polynom[(this->_knot_x.size() - 1) * 3 + 1];
+            return 2 * this->_polynom[(this->_knot_x.size() - 2) * 3] * x + //
+                   this->_polynom[(this->_knot_x.size() - 2) * 3 + 1];
         }
     }
 
@@ -163,6 +183,12 @@ public:
 
     void generate() override
     {
+        if (this->_knot_x.size() >= ParallelThreshold)
+        {
+            generateParallel();
+            return;
+        }
+
         std::vector<value_t> d(this->_knot_x.size()); // size N
         std::vector<value_t> w(this->_knot_x.size()); // size N
 
@@ -195,6 +221,38 @@ public:
         }
     }
 
+    /**
+     * @brief   Same as generate() but solves the w recurrence as two interleaved parallel prefix
+     *          scans (w[i] = d[i] - d[i - 1] + w[i - 2]). Used by generate() for large splines.
+     */
+    void generateParallel()
+    {
+        auto &x{this->_knot_x}, &y{this->_knot_y}, &p{this->_polynom};
+        const size_t n = x.size(), blocks = Parallel::numBlocks(n, 4096);
+
+        std::vector<value_t> d(n); // d[0] = 0
+        Parallel::forBlocks(n, blocks, 1, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = std::max<size_t>(begin, 1); i < end; ++i)
+                d[i] = 2 * (y[i] - y[i - 1]) / (x[i] - x[i - 1]);
+        });
+
+        std::vector<value_t> w(n); // w[0] = 0
+        Parallel::forBlocks(n, blocks, 1, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = std::max<size_t>(begin, 1); i < end; ++i) w[i] = d[i] - d[i - 1];
+        });
+        Parallel::inclusiveScan(w.data(), n, 2);
+
+        Parallel::forBlocks(n, blocks, 1, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = std::max<size_t>(begin, 1); i < end; ++i)
+            {
+                auto id = (i - 1) * 3;
+                p[id] = 0.5 * (w[i] - w[i - 1]) / (x[i] - x[i - 1]);
+                p[id + 1] = w[i - 1] - 2 * p[id] * x[i - 1];
+                p[id + 2] = p[id] * x[i - 1] * x[i - 1] - w[i - 1] * x[i - 1] + y[i - 1];
+            }
+        });
+    }
+
     value_t compute(value_t value) override
     {
         if (_uniform)
@@ -204,12 +262,10 @@ public:
         }
         else
         {
-            size_t id = 0;
-            while (!(this->_knot_x[id] <= value && value < this->_knot_x[id + 1]) &&
-                   id < this->_knot_x.size())
-            {
-                id++;
-            }
+            const size_t n{this->_knot_x.size()};
+            const size_t id{value < this->_intervall._end
+                                ? findSegment(this->_knot_x.data(), n, value)
+                                : n - 1};
 
             return polynomial(id, value);
         }
@@ -224,12 +280,10 @@ public:
         }
         else
         {
-            size_t id = 0;
-            while (!(this->_knot_x[id] <= value && value < this->_knot_x[id + 1]) &&
-                   id < this->_knot_x.size())
-            {
-                id++;
-            }
+            const size_t n{this->_knot_x.size()};
+            const size_t id{value < this->_intervall._end
+                                ? findSegment(this->_knot_x.data(), n, value)
+                                : n - 1};
 
             return polynomial_derivative(id, value);
         }
@@ -239,6 +293,246 @@ public:
     {
         return std::make_shared<QuadraticSpline<value_t>>(*this);
     }
+
+    // Integrals
+private:
+    /**
+     * @brief   Closed form integrals over [t0, t1] of a segment in local coordinates, i.e. of
+     *          a t^2 + b t + c with t = x - x_i.
+     */
+    struct Integrand
+    {
+        static value_t value(value_t a, value_t b, value_t c, value_t t0, value_t t1)
+        {
+            auto F = [&](value_t t) { return ((a / 3 * t + b / 2) * t + c) * t; };
+            return F(t1) - F(t0);
+        }
+
+        static value_t squared(value_t a, value_t b, value_t c, value_t t0, value_t t1)
+        {
+            auto F = [&](value_t t) {
+                return ((((a * a / 5 * t + a * b / 2) * t + (b * b + 2 * a * c) / 3) * t + b * c) *
+                            t +
+                        c * c) *
+                       t;
+            };
+            return F(t1) - F(t0);
+        }
+
+        static value_t derivativeSquared(value_t a, value_t b, value_t, value_t t0, value_t t1)
+        {
+            auto F = [&](value_t t) { return ((4 * a * a / 3 * t + 2 * a * b) * t + b * b) * t; };
+            return F(t1) - F(t0);
+        }
+
+        static value_t arcLength(value_t a, value_t b, value_t c, value_t t0, value_t t1)
+        {
+            using std::abs;
+            using std::ceil;
+            using std::sqrt;
+
+            // the integrand bends where the derivative vanishes, integrate both sides separately
+            if (a != value_t(0))
+            {
+                const value_t t{-b / (2 * a)};
+                if (t0 < t && t < t1) return arcLength(a, b, c, t0, t) + arcLength(a, b, c, t, t1);
+            }
+
+            // 5-point Gauss-Legendre quadrature (exact up to degree 9) on pieces over which the
+            // derivative changes by at most 1
+            constexpr value_t node[3]{value_t(0), value_t(0.5384693101056831),
+                                      value_t(0.9061798459386640)};
+            constexpr value_t weight[3]{value_t(0.5688888888888889), value_t(0.4786286704993665),
+                                        value_t(0.2369268850561891)};
+            auto f = [&](value_t t) {
+                const value_t d{2 * a * t + b};
+                return sqrt(1 + d * d);
+            };
+
+            const size_t pieces{std::clamp<size_t>(size_t(ceil(abs(2 * a * (t1 - t0)))), 1, 64)};
+            const value_t r{(t1 - t0) / value_t(2 * pieces)};
+            value_t sum{0};
+            for (size_t j = 0; j < pieces; ++j)
+            {
+                const value_t m{t0 + r * value_t(2 * j + 1)};
+                sum += weight[0] * f(m);
+                for (size_t k = 1; k < 3; ++k)
+                    sum += weight[k] * (f(m - r * node[k]) + f(m + r * node[k]));
+            }
+            return sum * r;
+        }
+    };
+
+    /**
+     * @brief   Evaluates kernel on the local coefficients of segment i over [t0, t1].
+     */
+    template <typename kernel_t>
+    value_t segmentIntegral(kernel_t kernel, size_t i, value_t t0, value_t t1) const
+    {
+        const value_t *p{&this->_polynom[3 * i]}, x_i{this->_knot_x[i]};
+        return kernel(p[0], 2 * p[0] * x_i + p[1], (p[0] * x_i + p[1]) * x_i + p[2], t0, t1);
+    }
+
+    template <typename kernel_t> value_t integral(kernel_t kernel, value_t a, value_t b) const
+    {
+        if (b < a) return -integral(kernel, b, a);
+
+        const auto & x{this->_knot_x};
+        a = std::max(a, x.front());
+        b = std::min(b, x.back());
+        if (!(a < b)) return value_t(0);
+
+        const size_t first{findSegment(x.data(), x.size(), a)},
+            last{findSegment(x.data(), x.size(), b)};
+        if (first == last) return segmentIntegral(kernel, first, a - x[first], b - x[first]);
+
+        value_t sum{segmentIntegral(kernel, first, a - x[first], x[first + 1] - x[first])};
+        for (size_t i = first + 1; i < last; ++i)
+            sum += segmentIntegral(kernel, i, value_t(0), x[i + 1] - x[i]);
+        return sum + segmentIntegral(kernel, last, value_t(0), b - x[last]);
+    }
+
+    /**
+     * @brief   Integrates over n intervalls [a_j, b_j] using a cumulative table of the segment
+     *          integrals which is computed segment-parallel. Each query costs O(log(segments)).
+     */
+    template <typename kernel_t>
+    void integral(kernel_t kernel, const value_t * a, const value_t * b, value_t * out,
+                  size_t n) const
+    {
+        const auto & x{this->_knot_x};
+        const size_t segments{x.size() - 1};
+
+        std::vector<value_t> cumulative(segments + 1, value_t(0));
+        Parallel::forBlocks(segments, Parallel::numBlocks(segments, 4096), 1,
+                            [&](size_t begin, size_t end, size_t) {
+                                for (size_t i = begin; i < end; ++i)
+                                    cumulative[i + 1] =
+                                        segmentIntegral(kernel, i, value_t(0), x[i + 1] - x[i]);
+                            });
+        Parallel::inclusiveScan(cumulative.data(), cumulative.size());
+
+        auto primitive = [&](value_t v) {
+            v = std::min(std::max(v, x.front()), x.back());
+            const size_t i{findSegment(x.data(), x.size(), v)};
+            return cumulative[i] + segmentIntegral(kernel, i, value_t(0), v - x[i]);
+        };
+        for (size_t j = 0; j < n; ++j) out[j] = primitive(b[j]) - primitive(a[j]);
+    }
+
+public:
+    /**
+     * @brief   Exact integral of the spline over [a, b] (clamped to the knots).
+     *          Execute QuadraticSpline::generate before usage.
+     */
+    value_t integrate(value_t a, value_t b) const { return integral(Integrand::value, a, b); }
+
+    /**
+     * @brief   Exact integral of the squared spline over [a, b].
+     */
+    value_t integrateSquared(value_t a, value_t b) const
+    {
+        return integral(Integrand::squared, a, b);
+    }
+
+    /**
+     * @brief   Exact integral of the squared derivative over [a, b] (bending energy).
+     */
+    value_t integrateDerivativeSquared(value_t a, value_t b) const
+    {
+        return integral(Integrand::derivativeSquared, a, b);
+    }
+
+    /**
+     * @brief   Arc length of the curve over [a, b] by 5-point Gauss quadrature per segment.
+     */
+    value_t arcLength(value_t a, value_t b) const { return integral(Integrand::arcLength, a, b); }
+
+    /**
+     * @brief   Batched version of integrate() for the intervalls [a_j, b_j], j < n.
+     */
+    void integrate(const value_t * a, const value_t * b, value_t * out, size_t n) const
+    {
+        integral(Integrand::value, a, b, out, n);
+    }
+
+    void integrateSquared(const value_t * a, const value_t * b, value_t * out, size_t n) const
+    {
+        integral(Integrand::squared, a, b, out, n);
+    }
+
+    void integrateDerivativeSquared(const value_t * a, const value_t * b, value_t * out,
+                                    size_t n) const
+    {
+        integral(Integrand::derivativeSquared, a, b, out, n);
+    }
+
+    void arcLength(const value_t * a, const value_t * b, value_t * out, size_t n) const
+    {
+        integral(Integrand::arcLength, a, b, out, n);
+    }
+
+    // Ranges
+public:
+    /**
+     * @brief   Exact minimum (_start) and maximum (_end) of segment i over [a, b], clamped to the
+     *          segment. The extremum of a t^2 + b t + c lies at the bounds or at t = -b / (2a).
+     */
+    Intervall<value_t> segmentRange(size_t i, value_t a, value_t b) const
+    {
+        const auto & x{this->_knot_x};
+        const value_t t0{std::max(std::min(a, b), x[i]) - x[i]},
+            t1{std::min(std::max(a, b), x[i + 1]) - x[i]};
+
+        const value_t * p{&this->_polynom[3 * i]};
+        const value_t pa{p[0]}, pb{2 * p[0] * x[i] + p[1]}, pc{(p[0] * x[i] + p[1]) * x[i] + p[2]};
+        auto f = [&](value_t t) { return (pa * t + pb) * t + pc; };
+
+        const value_t f0{f(t0)}, f1{f(t1)};
+        Intervall<value_t> range{std::min(f0, f1), std::max(f0, f1)};
+        if (pa != value_t(0))
+        {
+            const value_t t{-pb / (2 * pa)};
+            if (t0 < t && t < t1)
+            {
+                const value_t v{f(t)};
+                range._start = std::min(range._start, v);
+                range._end = std::max(range._end, v);
+            }
+        }
+        return range;
+    }
+
+    /**
+     * @brief   Minimum and maximum of segment i (the y-extent of its bounding box).
+     */
+    Intervall<value_t> segmentBounds(size_t i) const
+    {
+        return segmentRange(i, this->_knot_x[i], this->_knot_x[i + 1]);
+    }
+
+    /**
+     * @brief   Exact minimum and maximum of the spline over [a, b] (clamped to the knots), in
+     *          O(segments within [a, b]). See SplineRangeTree for logarithmic queries.
+     */
+    Intervall<value_t> rangeOver(value_t a, value_t b) const
+    {
+        const auto & x{this->_knot_x};
+        if (b < a) std::swap(a, b);
+        a = std::min(std::max(a, x.front()), x.back());
+        b = std::min(std::max(b, x.front()), x.back());
+
+        const size_t first{findSegment(x.data(), x.size(), a)},
+            last{findSegment(x.data(), x.size(), b)};
+        Intervall<value_t> range{segmentRange(first, a, b)};
+        for (size_t i = first + 1; i <= last; ++i)
+        {
+            const Intervall<value_t> r{segmentRange(i, a, b)};
+            range._start = std::min(range._start, r._start);
+            range._end = std::max(range._end, r._end);
+        }
+        return range;
+    }
 };
 
 } // namespace My
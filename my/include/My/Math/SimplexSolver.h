@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <iostream>
 #include <memory>
 #include <numeric>
 #include <vector>
@@ -8,7 +9,7 @@
 #include "Math/SimplexFunction.h"
 #include "Math/SimplexFunctionArgument.h"
 #include "Math/SimplexPair.h"
-#include "Utility/Utility.h"
+#include "Utility/Macros.h"
 
 namespace My::Math
 {
@@ -106,6 +107,8 @@ public:
      */
     SimplexPair<value_t> solve(bool print = true, int * num_iter = nullptr)
     {
+        using std::abs;
+
         if (print) std::cout << "> Initializing Simplex ... " << std::flush;
         initializeSimplex();
 
@@ -115,7 +118,7 @@ public:
         if (print) std::cout << "Done.\n> Run Simplex-Optimization ..." << std::flush;
 
         int k = 0;
-        while (sortSimplex() && (std::abs(_simplex[0] - _simplex[1]) > _tolerance)
+        while (sortSimplex() && (abs(_simplex[0] - _simplex[1]) > _tolerance)
 #ifdef _DEBUG
                && k < 200
 #endif
@@ -5,8 +5,6 @@
 #include <sstream>
 #include <vector>
 
-#include "Utility/Utility.h"
-
 #include "Math/Intervall.h"
 
 namespace My::Math
@@ -40,10 +38,10 @@ public:
      */
     Spline(size_t num_knots, Intervall<value_t> intervall)
         : _knot_x(num_knots), _knot_y(num_knots), _intervall{intervall},
-          _delta((_intervall._end - _intervall._start) / (num_knots - 1))
+          _delta((_intervall._end - _intervall._start) / value_t(num_knots - 1))
     {
-        for (value_t i = 0; i < num_knots; ++i)
-            _knot_x[i] = _intervall._start + i * _delta; // equally distributed x-values
+        for (size_t i = 0; i < num_knots; ++i)
+            _knot_x[i] = _intervall._start + value_t(i) * _delta; // equally distributed x-values
     }
 
     /**
@@ -116,6 +114,22 @@ public:
      */
     virtual void specifyX(size_t knot, value_t value) {}
 
+    /**
+     * @brief   Access the storage holding the free parameters of the spline (see
+     *          @ref SplineArgument). Override if these are not the y-knots.
+     */
+    virtual std::vector<value_t> & parameterStorage() { return _knot_y; }
+
+    /**
+     * @brief   Index of the first free parameter within parameterStorage().
+     */
+    virtual size_t parameterOffset() const { return 0; }
+
+    /**
+     * @brief   Number of free parameters within parameterStorage().
+     */
+    virtual size_t numParameters() const { return _knot_y.size(); }
+
     // Methods
 public:
     /**
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Math/SimplexFunction.h"
+#include "Math/SimplexFunctionArgument.h"
+#include "Math/Spline.h"
+
+namespace My::Math
+{
+
+/**
+ * @brief   Recycles the parameter buffers of the temporary @ref SplineArgument instances created
+ *          by the @ref SimplexSolver.
+ *
+ * Every buffer has the size of the spline's parameter storage. Entries outside of the free
+ * parameter range are initialized once from the spline and never modified.
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ *
+ * @ingroup Math
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+template <typename value_t>
+class SplineArgumentPool : public std::enable_shared_from_this<SplineArgumentPool<value_t>>
+{
+    // Data
+private:
+    std::vector<value_t> _template;
+    std::vector<std::unique_ptr<std::vector<value_t>>> _free;
+
+    // Constructors
+public:
+    SplineArgumentPool(std::vector<value_t> storage) : _template(std::move(storage)) {}
+
+    // Methods
+public:
+    /**
+     * @brief   Returns a buffer which goes back to the pool once released.
+     */
+    std::shared_ptr<std::vector<value_t>> acquire()
+    {
+        std::vector<value_t> * buffer;
+        if (_free.empty())
+            buffer = new std::vector<value_t>(_template);
+        else
+        {
+            buffer = _free.back().release();
+            _free.pop_back();
+        }
+
+        return std::shared_ptr<std::vector<value_t>>(
+            buffer, [pool = this->shared_from_this()](std::vector<value_t> * b) {
+                pool->_free.emplace_back(b);
+            });
+    }
+
+    /**
+     * @brief   Number of buffers currently waiting for reuse.
+     */
+    size_t numFree() const noexcept { return _free.size(); }
+};
+
+/**
+ * @brief   @ref SimplexFunctionArgument operating directly on the free parameters of a spline
+ *          (y-knots, curvatures or gradients, see Spline::parameterStorage).
+ *
+ * An argument created from a spline is a non-owning view onto the spline's storage. Results of
+ * the arithmetic operations store their parameters in buffers of a @ref SplineArgumentPool, which
+ * @ref SplineFunction swaps into the spline for evaluation. Hence no parameters are copied
+ * between solver vertices and spline.
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ *
+ * @ingroup Math
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+template <typename value_t> class SplineArgument : public SimplexFunctionArgument<value_t>
+{
+    // Data
+private:
+    std::shared_ptr<SplineArgumentPool<value_t>> _pool;
+    std::shared_ptr<std::vector<value_t>> _buffer; // nullptr for views
+    size_t _offset;                                // index of the first free parameter
+    value_t * _data;                               // first free parameter
+
+    // Constructors
+public:
+    /**
+     * @brief   Creates a view onto the parameters of the spline.
+     *
+     * @param   spline  The spline. Must outlive the argument.
+     */
+    SplineArgument(Spline<value_t> & spline)
+        : SimplexFunctionArgument<value_t>(spline.numParameters()),
+          _pool{std::make_shared<SplineArgumentPool<value_t>>(spline.parameterStorage())},
+          _offset{spline.parameterOffset()},
+          _data{spline.parameterStorage().data() + _offset}
+    {}
+
+    /**
+     * @brief   Creates an argument owning a pooled buffer.
+     */
+    SplineArgument(std::shared_ptr<SplineArgumentPool<value_t>> pool, size_t N, size_t offset)
+        : SimplexFunctionArgument<value_t>(N), _pool{std::move(pool)}, _buffer{_pool->acquire()},
+          _offset{offset}, _data{_buffer->data() + offset}
+    {}
+
+    // Properties
+public:
+    value_t get(size_t i) override { return _data[i]; }
+
+    void set(size_t i, value_t v) override { _data[i] = v; }
+
+    /**
+     * @brief   Whether this argument is a view onto a spline.
+     */
+    bool view() const noexcept { return !_buffer; }
+
+    /**
+     * @brief   The owned parameter storage (nullptr for views).
+     */
+    std::vector<value_t> * buffer() const noexcept { return _buffer.get(); }
+
+    const value_t * data() const noexcept { return _data; }
+
+    /**
+     * @brief   Writes the parameters into the spline (one copy, e.g. for the final solution).
+     */
+    void assignTo(Spline<value_t> & spline)
+    {
+        std::copy(_data, _data + this->N(), spline.parameterStorage().data() + _offset);
+    }
+
+    // Methods
+private:
+    template <typename func_t> std::shared_ptr<SimplexFunctionArgument<value_t>> map(func_t && f)
+    {
+        auto result = std::make_shared<SplineArgument<value_t>>(_pool, this->N(), _offset);
+        for (size_t i = 0; i < this->N(); ++i) result->_data[i] = f(i);
+        return result;
+    }
+
+public:
+    std::shared_ptr<SimplexFunctionArgument<value_t>>
+    add(std::shared_ptr<SimplexFunctionArgument<value_t>> other) override
+    {
+        const value_t * o{static_cast<SplineArgument<value_t> &>(*other)._data};
+        return map([this, o](size_t i) { return _data[i] + o[i]; });
+    }
+
+    std::shared_ptr<SimplexFunctionArgument<value_t>>
+    sub(std::shared_ptr<SimplexFunctionArgument<value_t>> other) override
+    {
+        const value_t * o{static_cast<SplineArgument<value_t> &>(*other)._data};
+        return map([this, o](size_t i) { return _data[i] - o[i]; });
+    }
+
+    std::shared_ptr<SimplexFunctionArgument<value_t>> div(value_t other) override
+    {
+        return map([this, other](size_t i) { return _data[i] / other; });
+    }
+
+    std::shared_ptr<SimplexFunctionArgument<value_t>> mul(value_t other) override
+    {
+        return map([this, other](size_t i) { return _data[i] * other; });
+    }
+
+    std::shared_ptr<SimplexFunctionArgument<value_t>> copy() override
+    {
+        return map([this](size_t i) { return _data[i]; });
+    }
+};
+
+/**
+ * @brief   @ref SimplexFunction whose argument is a @ref SplineArgument of the owned spline.
+ *
+ * compute() swaps the argument's buffer into the spline (no copy), calls generate() once and
+ * evaluates objective().
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ *
+ * @ingroup Math
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+template <typename value_t> class SplineFunction : public SimplexFunction<value_t>
+{
+    // Data
+protected:
+    std::shared_ptr<Spline<value_t>> _spline;
+
+    // Constructors
+public:
+    SplineFunction(std::shared_ptr<Spline<value_t>> spline) : _spline{std::move(spline)} {}
+
+    // Properties
+public:
+    std::shared_ptr<Spline<value_t>> spline() const { return _spline; }
+
+    /**
+     * @brief   Returns a view onto the current spline parameters as initial solver state.
+     */
+    std::shared_ptr<SplineArgument<value_t>> initialState()
+    {
+        return std::make_shared<SplineArgument<value_t>>(*_spline);
+    }
+
+    // Methods
+public:
+    /**
+     * @brief   The function to minimize. The spline is already generated.
+     */
+    virtual value_t objective(Spline<value_t> & spline) = 0;
+
+    value_t compute(const std::shared_ptr<SimplexFunctionArgument<value_t>> & t) override
+    {
+        auto * buffer = static_cast<SplineArgument<value_t> &>(*t).buffer();
+        auto & storage = _spline->parameterStorage();
+
+        if (buffer) std::swap(storage, *buffer);
+        _spline->generate();
+        value_t result = objective(*_spline);
+        if (buffer) std::swap(storage, *buffer);
+
+        return result;
+    }
+};
+
+} // namespace My::Math
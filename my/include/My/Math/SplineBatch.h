@@ -0,0 +1,316 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Math/Intervall.h"
+#include "Math/QuadraticSpline.h"
+#include "Math/SplineSegment.h"
+#include "Utility/AlignedAllocator.h"
+
+namespace My::Math
+{
+
+/**
+ * @brief   Container for many uniform quadratic splines sharing intervall and knot count.
+ *
+ * The data is stored structure-of-arrays with the spline index as fast axis, e.g. the
+ * coefficients as [segment][coefficient][spline]. Generation therefore runs one pass over the
+ * segments with contiguous (vectorizable) inner loops over all splines. The coefficients use the
+ * global layout of @ref Spline::polynomData.
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ *
+ * @ingroup Math
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+template <typename value_t> class SplineBatch
+{
+    // Data
+protected:
+    size_t _count, _num_knots;
+    Intervall<value_t> _intervall;
+    value_t _delta, _inv_delta;
+    Utility::AlignedVector<value_t> _polynom; // [segment][coefficient][spline]
+
+    // Constructors
+public:
+    /**
+     * @brief   Constructor for inheritance.
+     *
+     * @param   count       Number of splines.
+     * @param   num_knots   Number of knots of each spline.
+     * @param   intervall   The intervall in which the splines live.
+     */
+    SplineBatch(size_t count, size_t num_knots, Intervall<value_t> intervall)
+        : _count{count}, _num_knots{num_knots}, _intervall{intervall},
+          _delta{(intervall._end - intervall._start) / value_t(num_knots - 1)},
+          _inv_delta{value_t(num_knots - 1) / (intervall._end - intervall._start)},
+          _polynom((num_knots - 1) * 3 * count)
+    {}
+
+    virtual ~SplineBatch() = default;
+
+    // Properties
+public:
+    /**
+     * @brief   Number of splines.
+     */
+    size_t size() const noexcept { return _count; }
+
+    size_t numKnots() const noexcept { return _num_knots; }
+
+    Intervall<value_t> intervall() const noexcept { return _intervall; }
+
+    /**
+     * @brief   Access the coefficients structured as [segment][coefficient][spline].
+     */
+    const value_t * polynomData() const noexcept { return _polynom.data(); }
+
+    // Methods
+public:
+    /**
+     * @brief   Computes the coefficients of all splines.
+     */
+    virtual void generate() = 0;
+
+    /**
+     * @brief   Evaluates a single spline at x.
+     */
+    value_t compute(size_t spline, value_t x) const
+    {
+        const value_t * p{coefficients(segment(x)) + spline};
+        return (p[0] * x + p[_count]) * x + p[2 * _count];
+    }
+
+    /**
+     * @brief   Evaluates all splines at x.
+     *
+     * @param   x       The position.
+     * @param   out     Output values (size() elements).
+     */
+    void compute(value_t x, value_t * out) const
+    {
+        const value_t * p{coefficients(segment(x))};
+        const value_t *a{p}, *b{p + _count}, *c{p + 2 * _count};
+        for (size_t s = 0; s < _count; ++s) out[s] = (a[s] * x + b[s]) * x + c[s];
+    }
+
+    /**
+     * @brief   Evaluates a single spline at n positions.
+     */
+    void compute(size_t spline, const value_t * x, value_t * out, size_t n) const
+    {
+        for (size_t j = 0; j < n; ++j) out[j] = compute(spline, x[j]);
+    }
+
+    /**
+     * @brief   Extracts a single spline (same coefficients).
+     */
+    std::shared_ptr<QuadraticSpline<value_t>> spline(size_t spline) const
+    {
+        std::vector<value_t> knot_x(_num_knots), knot_y(_num_knots), polynom(3 * (_num_knots - 1));
+        for (size_t i = 0; i < _num_knots; ++i)
+            knot_x[i] = _intervall._start + value_t(i) * _delta;
+        for (size_t i = 0; i + 1 < _num_knots; ++i)
+        {
+            for (size_t k = 0; k < 3; ++k)
+                polynom[3 * i + k] = coefficients(i)[k * _count + spline];
+            knot_y[i] = compute(spline, knot_x[i]);
+        }
+        knot_y[_num_knots - 1] = compute(spline, _intervall._end);
+        return std::make_shared<QuadraticSpline<value_t>>(knot_x, knot_y, polynom);
+    }
+
+protected:
+    size_t segment(value_t x) const
+    {
+        return findUniformSegment(_intervall._start, _inv_delta, _num_knots - 1, x);
+    }
+
+    const value_t * coefficients(size_t segment) const { return &_polynom[segment * 3 * _count]; }
+
+    value_t * coefficients(size_t segment) { return &_polynom[segment * 3 * _count]; }
+};
+
+/**
+ * @brief   Batch of @ref CurvatureSpline instances.
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ *
+ * @ingroup Math
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+template <typename value_t> class CurvatureSplineBatch : public SplineBatch<value_t>
+{
+    // Data
+private:
+    Utility::AlignedVector<value_t> _a; // [curvature][spline]
+    Utility::AlignedVector<value_t> _y_0, _y_n;
+
+    // Constructors
+public:
+    CurvatureSplineBatch(size_t count, size_t num_a, Intervall<value_t> intervall)
+        : SplineBatch<value_t>(count, num_a + 1, intervall), _a(num_a * count), _y_0(count),
+          _y_n(count)
+    {}
+
+    // Properties
+public:
+    size_t numCurvatures() const noexcept { return this->_num_knots - 1; }
+
+    void curvature(size_t spline, size_t a, value_t v) { _a[a * this->_count + spline] = v; }
+
+    value_t curvature(size_t spline, size_t a) const { return _a[a * this->_count + spline]; }
+
+    /**
+     * @brief   Specify start and end value of a spline.
+     */
+    void boundary(size_t spline, value_t y_0, value_t y_n)
+    {
+        _y_0[spline] = y_0;
+        _y_n[spline] = y_n;
+    }
+
+    // Methods
+public:
+    void generate() override
+    {
+        const size_t n{this->_count}, m{numCurvatures()};
+        const value_t delta{this->_delta}, start{this->_intervall._start};
+
+        // alpha (see CurvatureSpline::calpha)
+        Utility::AlignedVector<value_t> alpha(n, value_t(0)), B(n, value_t(0));
+        for (size_t i = 0; i + 1 < m; ++i)
+        {
+            const value_t * a{&_a[i * n]};
+            const value_t weight{value_t(m - 2 - i)};
+            for (size_t s = 0; s < n; ++s)
+            {
+                alpha[s] += a[s];
+                B[s] += a[s] * weight;
+            }
+        }
+        const value_t * a_last{&_a[(m - 1) * n]};
+        for (size_t s = 0; s < n; ++s)
+            alpha[s] = (_y_n[s] - _y_0[s]) /
+                       ((delta * delta) * (a_last[s] + 3 * alpha[s] + 2 * B[s]));
+
+        // local coefficients b (tangent) and c (y-axis intersection) of the current segment
+        Utility::AlignedVector<value_t> b(n, value_t(0)), c(_y_0);
+        for (size_t i = 0; i < m; ++i)
+        {
+            value_t * p{this->coefficients(i)};
+            const value_t * a{&_a[i * n]};
+            const value_t x_i{start + delta * value_t(i)};
+            for (size_t s = 0; s < n; ++s)
+            {
+                // move into the corresponding area
+                const value_t a_i{alpha[s] * a[s]};
+                p[s] = a_i;
+                p[n + s] = b[s] - 2 * a_i * x_i;
+                p[2 * n + s] = c[s] + a_i * x_i * x_i - b[s] * x_i;
+
+                // advance to the next segment
+                c[s] += a_i * delta * delta + b[s] * delta;
+                b[s] += 2 * a_i * delta;
+            }
+        }
+    }
+};
+
+/**
+ * @brief   Batch of @ref GradientSpline instances.
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ *
+ * @ingroup Math
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+template <typename value_t> class GradientSplineBatch : public SplineBatch<value_t>
+{
+    // Data
+private:
+    Utility::AlignedVector<value_t> _eta; // [knot][spline], knot 0 is always 0
+    Utility::AlignedVector<value_t> _y_0, _y_n;
+    bool _last; // whether the last segment is fitted to y_n
+
+    // Constructors
+public:
+    /**
+     * @brief   Create new instance.
+     *
+     * @param   count           Number of splines.
+     * @param   num_gradients   Number of gradients of each spline.
+     * @param   intervall       The intervall in which the splines live.
+     * @param   last            Whether the splines end in y_n (see GradientSpline).
+     */
+    GradientSplineBatch(size_t count, size_t num_gradients, Intervall<value_t> intervall,
+                        bool last = true)
+        : SplineBatch<value_t>(count, num_gradients + (last ? 2 : 1), intervall),
+          _eta((num_gradients + (last ? 2 : 1)) * count), _y_0(count), _y_n(count), _last{last}
+    {}
+
+    // Properties
+public:
+    size_t numGradients() const noexcept { return this->_num_knots - (_last ? 2 : 1); }
+
+    void gradient(size_t spline, size_t i, value_t v) { _eta[(i + 1) * this->_count + spline] = v; }
+
+    value_t gradient(size_t spline, size_t i) const
+    {
+        return _eta[(i + 1) * this->_count + spline];
+    }
+
+    /**
+     * @brief   Specify start and end value of a spline. y_n is ignored without fixed end.
+     */
+    void boundary(size_t spline, value_t y_0, value_t y_n = 0)
+    {
+        _y_0[spline] = y_0;
+        _y_n[spline] = y_n;
+    }
+
+    // Methods
+public:
+    void generate() override
+    {
+        const size_t n{this->_count}, border{numGradients()};
+        const value_t delta{this->_delta};
+
+        Utility::AlignedVector<value_t> y(_y_0);
+        for (size_t i = 1; i < border + 1; ++i)
+        {
+            value_t * p{this->coefficients(i - 1)};
+            const value_t *eta_0{&_eta[(i - 1) * n]}, *eta_1{&_eta[i * n]};
+            const value_t x{this->_intervall._start + delta * value_t(i - 1)};
+            for (size_t s = 0; s < n; ++s)
+            {
+                p[s] = (eta_1[s] - eta_0[s]) / (2 * delta);
+                p[n + s] = (x * (eta_0[s] - eta_1[s])) / delta + eta_0[s];
+                p[2 * n + s] =
+                    (x * x * (eta_1[s] - eta_0[s])) / (2 * delta) - x * eta_0[s] + y[s];
+                y[s] += (delta * (eta_0[s] + eta_1[s])) / 2;
+            }
+        }
+
+        if (_last)
+        {
+            const size_t last{this->_num_knots - 1};
+            value_t * p{this->coefficients(last - 1)};
+            const value_t * eta{&_eta[(last - 1) * n]};
+            const value_t x{this->_intervall._start + delta * value_t(last - 1)};
+            const value_t dd{delta * delta};
+            for (size_t s = 0; s < n; ++s)
+            {
+                p[s] = (-y[s] + _y_n[s] - delta * eta[s]) / dd;
+                p[n + s] = (2 * x * y[s] - 2 * x * _y_n[s] + 2 * delta * x * eta[s]) / dd + eta[s];
+                p[2 * n + s] = (_y_n[s] * x * x + y[s] * dd - y[s] * x * x - x * eta[s] * dd -
+                                delta * eta[s] * x * x) /
+                               dd;
+            }
+        }
+    }
+};
+
+} // namespace My::Math
@@ -0,0 +1,355 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "Math/CurvatureSpline.h"
+#include "Math/GradientSpline.h"
+#include "Math/QuadraticSpline.h"
+#include "Math/SplineSegment.h"
+
+namespace My::Math
+{
+
+/**
+ * @brief   Weighted least-squares fit of a quadratic spline to streamed samples.
+ *
+ * The fit is computed in the quadratic B-spline basis over the knots of the target spline. Every
+ * sample touches three neighbouring basis functions, so the normal equations are banded (half
+ * bandwidth 2) and are accumulated in O(1) memory per knot, independent of the number of samples.
+ * add() may therefore be called with arbitrary chunks (e.g. while reading a large point cloud).
+ * solve() uses a banded Cholesky factorization in O(knots).
+ *
+ * The boundary conditions of the target spline are part of the basis: the derivative at the first
+ * knot vanishes (all splines), CurvatureSpline and GradientSpline additionally start at y_0 and
+ * CurvatureSpline (and GradientSpline with fixed end) end at y_n.
+ *
+ * The optional smoothing adds smoothing * sum (c_k - 2 c_{k+1} + c_{k+2})^2 over the B-spline
+ * coefficients c_k (P-spline penalty). It is required if some segments contain too few samples.
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ *
+ * @ingroup Math
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+template <typename value_t> class SplineFitter
+{
+    // Data
+private:
+    static constexpr size_t Fixed{size_t(-1)};
+
+    std::vector<value_t> _x;            // spline knots
+    std::vector<value_t> _t;            // B-spline knot vector (clamped)
+    std::vector<size_t> _unknown;       // basis function -> unknown (Fixed for fixed coefficients)
+    std::vector<value_t> _fixed;        // values of the fixed basis coefficients
+    std::vector<value_t> _normal;       // banded normal matrix, [row][diagonal 0..2]
+    std::vector<value_t> _rhs;          // right hand side
+    std::vector<value_t> _coefficients; // solved B-spline coefficients
+    value_t _smoothing;
+    size_t _num_samples{0};
+    bool _solved{false};
+
+    // Constructors
+public:
+    /**
+     * @brief   Prepares fitting the knot values of a QuadraticSpline.
+     *
+     * @param   spline      The target spline (only the knots are used).
+     * @param   smoothing   Weight of the second difference penalty.
+     */
+    SplineFitter(const QuadraticSpline<value_t> & spline, value_t smoothing = 0)
+        : SplineFitter(spline.X(), smoothing, false, 0, false, 0)
+    {}
+
+    /**
+     * @brief   Prepares fitting the curvatures of a CurvatureSpline with its y_0 and y_n.
+     */
+    SplineFitter(const CurvatureSpline<value_t> & spline, value_t smoothing = 0)
+        : SplineFitter(spline.X(), smoothing, true, spline.y0(), true, spline.yn())
+    {}
+
+    /**
+     * @brief   Prepares fitting the gradients of a GradientSpline with its y_0 (and y_n).
+     */
+    SplineFitter(const GradientSpline<value_t> & spline, value_t smoothing = 0)
+        : SplineFitter(spline.X(), smoothing, true, spline.Y().front(), spline.fixedEnd(),
+                       spline.Y().back())
+    {}
+
+private:
+    SplineFitter(const std::vector<value_t> & knot_x, value_t smoothing, bool fixed_start,
+                 value_t y_0, bool fixed_end, value_t y_n)
+        : _x(knot_x), _smoothing{smoothing}
+    {
+        const size_t n{_x.size() - 1}; // segments, n + 2 basis functions
+
+        _t.reserve(n + 5);
+        _t.insert(_t.end(), 2, _x.front());
+        _t.insert(_t.end(), _x.begin(), _x.end());
+        _t.insert(_t.end(), 2, _x.back());
+
+        // c_0 = c_1 gives the vanishing derivative at the first knot
+        _unknown.assign(n + 2, Fixed);
+        _fixed.assign(n + 2, value_t(0));
+        size_t num_unknowns{0};
+        if (fixed_start)
+            _fixed[0] = _fixed[1] = y_0;
+        else
+            _unknown[0] = _unknown[1] = num_unknowns++;
+        for (size_t k = 2; k < n + 2; ++k)
+        {
+            if (fixed_end && k == n + 1)
+                _fixed[k] = y_n;
+            else
+                _unknown[k] = num_unknowns++;
+        }
+
+        _normal.resize(3 * num_unknowns);
+        _rhs.resize(num_unknowns);
+        _coefficients.resize(n + 2);
+        reset();
+    }
+
+    // Properties
+public:
+    size_t numKnots() const noexcept { return _x.size(); }
+
+    /**
+     * @brief   Number of unknowns of the linear system.
+     */
+    size_t numUnknowns() const noexcept { return _rhs.size(); }
+
+    size_t numSamples() const noexcept { return _num_samples; }
+
+    value_t smoothing() const noexcept { return _smoothing; }
+
+    // Methods
+public:
+    /**
+     * @brief   Discards all samples.
+     */
+    void reset()
+    {
+        std::fill(_normal.begin(), _normal.end(), value_t(0));
+        std::fill(_rhs.begin(), _rhs.end(), value_t(0));
+        _num_samples = 0;
+        _solved = false;
+    }
+
+    /**
+     * @brief   Adds a sample. Samples outside of the knot range are ignored.
+     */
+    void add(value_t x, value_t y, value_t weight = 1)
+    {
+        if (!(x >= _x.front() && x <= _x.back()) || weight <= 0) return;
+
+        const size_t j{findSegment(_x.data(), _x.size(), x)};
+        accumulate(j, basis(j, x), y, weight);
+        ++_num_samples;
+        _solved = false;
+    }
+
+    /**
+     * @brief   Adds a chunk of n samples.
+     *
+     * @param   x       Sample positions.
+     * @param   y       Sample values.
+     * @param   n       Number of samples.
+     * @param   weights Sample weights (nullptr for 1).
+     */
+    void add(const value_t * x, const value_t * y, size_t n, const value_t * weights = nullptr)
+    {
+        for (size_t i = 0; i < n; ++i) add(x[i], y[i], weights ? weights[i] : value_t(1));
+    }
+
+    /**
+     * @brief   Solves the normal equations. Throws if the system is singular, i.e. if there are
+     *          not enough samples; increase the smoothing in that case.
+     */
+    void solve()
+    {
+        using std::sqrt;
+
+        const size_t n{numUnknowns()};
+
+        std::vector<value_t> a(_normal), l(3 * n), z(_rhs);
+        if (_smoothing > 0)
+            for (size_t k = 0; k + 2 < _coefficients.size(); ++k)
+                accumulate(k, {1, -2, 1}, 0, _smoothing, a.data(), z.data());
+
+        // banded Cholesky, a[3 * j + d] = A(j, j + d), l[3 * i + d] = L(i, i - d)
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t d = std::min<size_t>(i, 2) + 1; d-- > 0;)
+            {
+                const size_t j{i - d};
+                value_t sum{a[3 * j + d]};
+                for (size_t k = (i < 2 ? 0 : i - 2); k < j; ++k)
+                    sum -= l[3 * i + (i - k)] * l[3 * j + (j - k)];
+
+                if (d)
+                    l[3 * i + d] = sum / l[3 * j];
+                else
+                {
+                    if (!(sum > 0))
+                        throw std::runtime_error("SplineFitter: normal equations are singular.");
+                    l[3 * i] = sqrt(sum);
+                }
+            }
+        }
+
+        // L z = rhs, L^T u = z
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t d = 1; d <= std::min<size_t>(i, 2); ++d) z[i] -= l[3 * i + d] * z[i - d];
+            z[i] /= l[3 * i];
+        }
+        for (size_t i = n; i-- > 0;)
+        {
+            for (size_t d = 1; d <= 2 && i + d < n; ++d) z[i] -= l[3 * (i + d) + d] * z[i + d];
+            z[i] /= l[3 * i];
+        }
+
+        for (size_t k = 0; k < _coefficients.size(); ++k)
+            _coefficients[k] = _unknown[k] == Fixed ? _fixed[k] : z[_unknown[k]];
+        _solved = true;
+    }
+
+    /**
+     * @brief   Evaluates the fitted spline at x (solves if necessary).
+     */
+    value_t compute(value_t x)
+    {
+        if (!_solved) solve();
+        const size_t j{findSegment(_x.data(), _x.size(), x)};
+        const auto phi{basis(j, std::min(std::max(x, _x.front()), _x.back()))};
+        return phi[0] * _coefficients[j] + phi[1] * _coefficients[j + 1] +
+               phi[2] * _coefficients[j + 2];
+    }
+
+    /**
+     * @brief   Writes the fitted knot values into the spline and generates it.
+     */
+    void apply(QuadraticSpline<value_t> & spline)
+    {
+        checkKnots(spline);
+        for (size_t i = 0; i < _x.size(); ++i) spline.specify(i, compute(_x[i]));
+        spline.generate();
+    }
+
+    /**
+     * @brief   Writes the fitted curvatures into the spline and generates it.
+     */
+    void apply(CurvatureSpline<value_t> & spline)
+    {
+        checkKnots(spline);
+        if (!_solved) solve();
+        for (size_t j = 0; j + 1 < _x.size(); ++j) spline.curvature(j, local(j)[0]);
+        spline.generate();
+    }
+
+    /**
+     * @brief   Writes the fitted gradients into the spline and generates it.
+     */
+    void apply(GradientSpline<value_t> & spline)
+    {
+        checkKnots(spline);
+        if (!_solved) solve();
+        for (size_t i = 1; i <= spline.numParameters(); ++i) spline.specify(i, local(i)[1]);
+        spline.generate();
+    }
+
+private:
+    void checkKnots(const Spline<value_t> & spline) const
+    {
+        if (spline.numKnots() != _x.size())
+            throw std::runtime_error("SplineFitter: spline has a different number of knots.");
+    }
+
+    /**
+     * @brief   Values of the three quadratic B-splines B_j, B_j+1, B_j+2 non-zero on segment j
+     *          (Cox-de Boor).
+     */
+    std::array<value_t, 3> basis(size_t j, value_t x) const
+    {
+        const size_t s{j + 2}; // knot span within _t
+        std::array<value_t, 3> N{1, 0, 0};
+        value_t left[3], right[3];
+        for (size_t k = 1; k <= 2; ++k)
+        {
+            left[k] = x - _t[s + 1 - k];
+            right[k] = _t[s + k] - x;
+            value_t saved{0};
+            for (size_t r = 0; r < k; ++r)
+            {
+                const value_t temp{N[r] / (right[r + 1] + left[k - r])};
+                N[r] = saved + right[r + 1] * temp;
+                saved = left[k - r] * temp;
+            }
+            N[k] = saved;
+        }
+        return N;
+    }
+
+    /**
+     * @brief   Local coefficients a, b, c of segment j (see LocalQuadraticSpline). For j equal to
+     *          the number of segments the derivative at the last knot is returned as b.
+     */
+    std::array<value_t, 3> local(size_t j) const
+    {
+        const size_t last{_x.size() - 2};
+        const size_t i{std::min(j, last)};
+        const value_t h{_x[i + 1] - _x[i]};
+        const auto value = [this, i](value_t x) {
+            const auto phi{basis(i, x)};
+            return phi[0] * _coefficients[i] + phi[1] * _coefficients[i + 1] +
+                   phi[2] * _coefficients[i + 2];
+        };
+
+        const value_t v_0{value(_x[i])}, v_m{value(_x[i] + h / 2)}, v_1{value(_x[i + 1])};
+        const value_t a{2 * (v_1 - 2 * v_m + v_0) / (h * h)};
+        const value_t b{(v_1 - v_0) / h - a * h};
+        if (j > last) return {a, 2 * a * h + b, v_1};
+        return {a, b, v_0};
+    }
+
+    /**
+     * @brief   Adds the observation sum_k phi[k] * c_(j + k) = y to the normal equations.
+     */
+    void accumulate(size_t j, const std::array<value_t, 3> & phi, value_t y, value_t weight)
+    {
+        accumulate(j, phi, y, weight, _normal.data(), _rhs.data());
+    }
+
+    void accumulate(size_t j, const std::array<value_t, 3> & phi, value_t y, value_t weight,
+                    value_t * normal, value_t * rhs) const
+    {
+        // merge basis functions sharing an unknown and move fixed ones to the right hand side
+        size_t u[3];
+        value_t v[3];
+        size_t m{0};
+        for (size_t k = 0; k < 3; ++k)
+        {
+            const size_t unknown{_unknown[j + k]};
+            if (unknown == Fixed)
+                y -= phi[k] * _fixed[j + k];
+            else if (m && u[m - 1] == unknown)
+                v[m - 1] += phi[k];
+            else
+            {
+                u[m] = unknown;
+                v[m++] = phi[k];
+            }
+        }
+
+        for (size_t r = 0; r < m; ++r)
+        {
+            rhs[u[r]] += weight * v[r] * y;
+            for (size_t c = r; c < m; ++c) normal[3 * u[r] + (u[c] - u[r])] += weight * v[r] * v[c];
+        }
+    }
+};
+
+} // namespace My::Math
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "Math/Intervall.h"
+#include "Math/Parallel.h"
+#include "Math/QuadraticSpline.h"
+#include "Math/SplineSegment.h"
+
+namespace My::Math
+{
+
+/**
+ * @brief   Min/max tree over the segment bounds of a generated @ref QuadraticSpline for range
+ *          queries in O(log(segments)).
+ *
+ * The leaves hold the exact segment ranges (QuadraticSpline::segmentBounds), inner nodes the
+ * union of their children. A query over [a, b] evaluates the two partially covered boundary
+ * segments exactly and combines the fully covered ones from the tree. Rebuild after changing and
+ * regenerating the spline.
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ *
+ * @ingroup Math
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+template <typename value_t> class SplineRangeTree
+{
+    // Data
+private:
+    const QuadraticSpline<value_t> * _spline;
+    size_t _segments;
+    std::vector<value_t> _min, _max; // implicit tree, leaves at [_segments, 2 * _segments)
+
+    // Constructors
+public:
+    /**
+     * @brief   Builds the tree in O(segments).
+     *
+     * @param   spline  The generated spline. Must outlive the tree.
+     */
+    SplineRangeTree(const QuadraticSpline<value_t> & spline)
+        : _spline{&spline}, _segments{spline.numKnots() - 1}, _min(2 * _segments),
+          _max(2 * _segments)
+    {
+        Parallel::forBlocks(_segments, Parallel::numBlocks(_segments, 4096), 1,
+                            [this](size_t begin, size_t end, size_t) {
+                                for (size_t i = begin; i < end; ++i)
+                                {
+                                    const Intervall<value_t> r{_spline->segmentBounds(i)};
+                                    _min[_segments + i] = r._start;
+                                    _max[_segments + i] = r._end;
+                                }
+                            });
+        for (size_t i = _segments; i-- > 1;)
+        {
+            _min[i] = std::min(_min[2 * i], _min[2 * i + 1]);
+            _max[i] = std::max(_max[2 * i], _max[2 * i + 1]);
+        }
+    }
+
+    // Properties
+public:
+    size_t numSegments() const noexcept { return _segments; }
+
+    /**
+     * @brief   Bounding box of segment i: [x_i, x_i+1] x bounds(i).
+     */
+    Intervall<value_t> bounds(size_t i) const
+    {
+        return {_min[_segments + i], _max[_segments + i]};
+    }
+
+    /**
+     * @brief   Minimum and maximum of the whole spline.
+     */
+    Intervall<value_t> bounds() const
+    {
+        return _segments > 1 ? Intervall<value_t>{_min[1], _max[1]} : bounds(0);
+    }
+
+    // Methods
+public:
+    /**
+     * @brief   Exact minimum (_start) and maximum (_end) over [a, b], clamped to the knots.
+     */
+    Intervall<value_t> rangeOver(value_t a, value_t b) const
+    {
+        const auto & x{_spline->X()};
+        if (b < a) std::swap(a, b);
+        a = std::min(std::max(a, x.front()), x.back());
+        b = std::min(std::max(b, x.front()), x.back());
+
+        const size_t first{findSegment(x.data(), x.size(), a)},
+            last{findSegment(x.data(), x.size(), b)};
+        Intervall<value_t> range{_spline->segmentRange(first, a, b)};
+        if (first == last) return range;
+
+        const Intervall<value_t> r{_spline->segmentRange(last, a, b)};
+        range._start = std::min(range._start, r._start);
+        range._end = std::max(range._end, r._end);
+
+        // fully covered segments [first + 1, last)
+        for (size_t l = first + 1 + _segments, h = last + _segments; l < h; l /= 2, h /= 2)
+        {
+            if (l & 1)
+            {
+                range._start = std::min(range._start, _min[l]);
+                range._end = std::max(range._end, _max[l++]);
+            }
+            if (h & 1)
+            {
+                range._start = std::min(range._start, _min[--h]);
+                range._end = std::max(range._end, _max[h]);
+            }
+        }
+        return range;
+    }
+
+    /**
+     * @brief   Batched version of rangeOver() for the intervalls [a_j, b_j], j < n.
+     */
+    void rangeOver(const value_t * a, const value_t * b, Intervall<value_t> * out, size_t n) const
+    {
+        for (size_t j = 0; j < n; ++j) out[j] = rangeOver(a[j], b[j]);
+    }
+
+    /**
+     * @brief   Whether the spline stays within [lower, upper] on [a, b].
+     */
+    bool within(value_t a, value_t b, value_t lower, value_t upper) const
+    {
+        const Intervall<value_t> range{rangeOver(a, b)};
+        return lower <= range._start && range._end <= upper;
+    }
+};
+
+} // namespace My::Math
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <algorithm>
+
+namespace My::Math
+{
+
+/**
+ * @brief   Finds the segment [x_i, x_i+1) containing x by binary search over the knots. Values
+ *          outside of the knots are mapped to the first respectively last segment.
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ *
+ * @param   knot_x      The (sorted) knot x-values.
+ * @param   num_knots   The number of knots (>= 2).
+ * @param   x           The position to search.
+ *
+ * @return  The segment index in [0, num_knots - 2].
+ *
+ * @ingroup Math
+ */
+template <typename value_t>
+constexpr size_t findSegment(const value_t * knot_x, size_t num_knots, value_t x)
+{
+    const value_t * it = std::upper_bound(knot_x + 1, knot_x + num_knots - 1, x);
+    return size_t(it - knot_x) - 1;
+}
+
+/**
+ * @brief   Finds the segment containing x for equally distributed knots. Values outside of the
+ *          intervall are mapped to the first respectively last segment.
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ *
+ * @param   start           Start of the intervall.
+ * @param   inv_delta       Inverse knot distance.
+ * @param   num_segments    Number of segments (>= 1).
+ * @param   x               The position to search.
+ *
+ * @return  The segment index in [0, num_segments - 1].
+ *
+ * @ingroup Math
+ */
+template <typename value_t>
+constexpr size_t findUniformSegment(value_t start, value_t inv_delta, size_t num_segments,
+                                    value_t x)
+{
+    value_t t = (x - start) * inv_delta;
+    t = t < value_t(0) ? value_t(0) : t;
+    t = t > value_t(num_segments - 1) ? value_t(num_segments - 1) : t;
+    return size_t(t);
+}
+
+/**
+ * @brief   Evaluates a segment of coefficients in the layout of Spline::polynomData.
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ *
+ * @param   polynom     The coefficients: a_0, b_0, c_0, a_1, ...
+ * @param   segment     The segment index.
+ * @param   x           The position.
+ *
+ * @ingroup Math
+ */
+template <typename value_t>
+constexpr value_t evaluateSegment(const value_t * polynom, size_t segment, value_t x)
+{
+    const value_t * p = polynom + 3 * segment;
+    return (p[0] * x + p[1]) * x + p[2];
+}
+
+/**
+ * @brief   Evaluates the derivative of a segment of coefficients in the layout of
+ *          Spline::polynomData.
+ *
+ * @ingroup Math
+ */
+template <typename value_t>
+constexpr value_t evaluateSegmentDerivative(const value_t * polynom, size_t segment, value_t x)
+{
+    const value_t * p = polynom + 3 * segment;
+    return 2 * p[0] * x + p[1];
+}
+
+} // namespace My::Math
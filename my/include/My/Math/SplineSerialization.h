@@ -0,0 +1,400 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Math/CurvatureSpline.h"
+#include "Math/GradientSpline.h"
+#include "Math/Intervall.h"
+#include "Math/QuadraticSpline.h"
+#include "Math/SplineSegment.h"
+
+namespace My::Math
+{
+
+static_assert(std::endian::native == std::endian::little,
+              "The spline file format is little endian and read without conversion.");
+
+/**
+ * @brief   Type tag of a serialized spline.
+ *
+ * @ingroup Math
+ */
+enum class SplineType : uint32_t
+{
+    Quadratic = 1,
+    Curvature = 2,
+    Gradient = 3
+};
+
+/**
+ * @brief   Header of a spline file, followed by count uint64_t record offsets (bytes from the
+ *          file start) and the records.
+ *
+ * A record consists of a @ref SplineRecordHeader and the value_t arrays
+ * start, end, y_0, y_n | knot_x[num_knots] | knot_y[num_knots] | polynom[3 * (num_knots - 1)] |
+ * parameters[num_parameters]. Records are 8 byte aligned, all data is little endian.
+ *
+ * @ingroup Math
+ */
+struct SplineFileHeader
+{
+    static constexpr char Magic[4]{'M', 'Y', 'S', 'P'};
+    static constexpr uint16_t CurrentVersion{1};
+
+    char magic[4];
+    uint16_t version;
+    uint16_t value_size; // sizeof(value_t)
+    uint64_t count;
+};
+
+/**
+ * @brief   Header of a single spline record.
+ *
+ * @ingroup Math
+ */
+struct SplineRecordHeader
+{
+    static constexpr uint32_t Uniform{1}, FixedEnd{2};
+
+    SplineType type;
+    uint32_t flags;
+    uint64_t num_knots;
+    uint64_t num_parameters; // curvatures of a CurvatureSpline, 0 otherwise
+};
+
+static_assert(sizeof(SplineFileHeader) == 16 && sizeof(SplineRecordHeader) == 24);
+
+/**
+ * @brief   Serializes generated splines into the binary spline format.
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ *
+ * @ingroup Math
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+template <typename value_t> class SplineWriter
+{
+    // Data
+private:
+    std::vector<std::vector<char>> _records;
+
+    // Properties
+public:
+    size_t size() const noexcept { return _records.size(); }
+
+    // Methods
+public:
+    /**
+     * @brief   Appends a generated QuadraticSpline, CurvatureSpline or GradientSpline.
+     *
+     * @return  The index of the spline within the file.
+     */
+    size_t add(Spline<value_t> & spline)
+    {
+        SplineRecordHeader header{SplineType::Quadratic, 0, spline.numKnots(), 0};
+        value_t y_0{spline.Y().front()}, y_n{spline.Y().back()};
+        const value_t * parameters{nullptr};
+
+        if (auto * c = dynamic_cast<CurvatureSpline<value_t> *>(&spline))
+        {
+            header.type = SplineType::Curvature;
+            header.num_parameters = c->numParameters();
+            parameters = c->parameterStorage().data();
+            y_0 = c->y0();
+            y_n = c->yn();
+        }
+        else if (auto * g = dynamic_cast<GradientSpline<value_t> *>(&spline))
+        {
+            header.type = SplineType::Gradient;
+            if (g->fixedEnd()) header.flags |= SplineRecordHeader::FixedEnd;
+        }
+        else if (!dynamic_cast<QuadraticSpline<value_t> *>(&spline))
+            throw std::runtime_error("SplineWriter: unsupported spline type.");
+
+        if (static_cast<QuadraticSpline<value_t> &>(spline).uniform())
+            header.flags |= SplineRecordHeader::Uniform;
+
+        const size_t n{header.num_knots};
+        std::vector<char> & record{_records.emplace_back()};
+        record.reserve(sizeof(header) + (4 + 5 * n + header.num_parameters) * sizeof(value_t));
+
+        append(record, &header, sizeof(header));
+        const value_t scalars[4]{spline.intervall()._start, spline.intervall()._end, y_0, y_n};
+        append(record, scalars, sizeof(scalars));
+        append(record, spline.knotXData(), n * sizeof(value_t));
+        append(record, spline.knotYData(), n * sizeof(value_t));
+        append(record, spline.polynomData(), 3 * (n - 1) * sizeof(value_t));
+        append(record, parameters, header.num_parameters * sizeof(value_t));
+        record.resize(align(record.size()), 0);
+
+        return _records.size() - 1;
+    }
+
+    /**
+     * @brief   Writes the file to the stream.
+     */
+    void write(std::ostream & os) const
+    {
+        const SplineFileHeader header{
+            {SplineFileHeader::Magic[0], SplineFileHeader::Magic[1], SplineFileHeader::Magic[2],
+             SplineFileHeader::Magic[3]},
+            SplineFileHeader::CurrentVersion,
+            uint16_t(sizeof(value_t)),
+            _records.size()};
+
+        std::vector<uint64_t> offsets(_records.size());
+        uint64_t offset{align(sizeof(header) + offsets.size() * sizeof(uint64_t))};
+        for (size_t i = 0; i < _records.size(); ++i)
+        {
+            offsets[i] = offset;
+            offset += _records[i].size();
+        }
+
+        const char padding[8]{};
+        const size_t table_end{sizeof(header) + offsets.size() * sizeof(uint64_t)};
+        os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        os.write(reinterpret_cast<const char *>(offsets.data()), offsets.size() * sizeof(uint64_t));
+        os.write(padding, align(table_end) - table_end);
+        for (const auto & record : _records) os.write(record.data(), record.size());
+    }
+
+    /**
+     * @brief   Writes the file to disk.
+     */
+    void save(const std::string & filename) const
+    {
+        std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+        write(file);
+        if (!file) throw std::runtime_error("Could not write file.");
+    }
+
+private:
+    static void append(std::vector<char> & record, const void * data, size_t bytes)
+    {
+        const char * begin{static_cast<const char *>(data)};
+        if (bytes) record.insert(record.end(), begin, begin + bytes);
+    }
+
+    static constexpr size_t align(size_t bytes) { return (bytes + 7) & ~size_t(7); }
+};
+
+/**
+ * @brief   Read-only spline evaluating directly from a serialized record (e.g. within a memory
+ *          mapped file). Nothing is copied, the record must outlive the view.
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ *
+ * @ingroup Math
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+template <typename value_t> class SplineView
+{
+    // Data
+private:
+    const SplineRecordHeader * _header;
+    const value_t * _scalars; // start, end, y_0, y_n
+    const value_t *_knot_x, *_knot_y, *_polynom, *_parameters;
+    value_t _inv_delta{0};
+
+    // Constructors
+public:
+    /**
+     * @brief   Create a view onto a record.
+     *
+     * @param   record  The record, aligned to 8 bytes.
+     */
+    explicit SplineView(const void * record)
+        : _header{static_cast<const SplineRecordHeader *>(record)},
+          _scalars{reinterpret_cast<const value_t *>(_header + 1)}, _knot_x{_scalars + 4},
+          _knot_y{_knot_x + _header->num_knots}, _polynom{_knot_y + _header->num_knots},
+          _parameters{_polynom + 3 * (_header->num_knots - 1)}
+    {
+        if (uniform()) _inv_delta = value_t(numKnots() - 1) / (_scalars[1] - _scalars[0]);
+    }
+
+    // Properties
+public:
+    SplineType type() const noexcept { return _header->type; }
+
+    bool uniform() const noexcept { return _header->flags & SplineRecordHeader::Uniform; }
+
+    Intervall<value_t> intervall() const noexcept { return {_scalars[0], _scalars[1]}; }
+
+    size_t numKnots() const noexcept { return _header->num_knots; }
+
+    const value_t * knotXData() const noexcept { return _knot_x; }
+
+    const value_t * knotYData() const noexcept { return _knot_y; }
+
+    /**
+     * @brief   The coefficients in the layout of Spline::polynomData.
+     */
+    const value_t * polynomData() const noexcept { return _polynom; }
+
+    /**
+     * @brief   Size of the record in bytes (without alignment padding).
+     */
+    size_t recordBytes() const noexcept
+    {
+        return sizeof(SplineRecordHeader) +
+               (4 + 5 * numKnots() - 3 + _header->num_parameters) * sizeof(value_t);
+    }
+
+    // Methods
+public:
+    /**
+     * @brief   Returns the segment containing x (clamped to the first/last segment).
+     */
+    size_t segment(value_t x) const
+    {
+        return uniform() ? findUniformSegment(_scalars[0], _inv_delta, numKnots() - 1, x)
+                         : findSegment(_knot_x, numKnots(), x);
+    }
+
+    value_t compute(value_t x) const { return evaluateSegment(_polynom, segment(x), x); }
+
+    value_t operator()(value_t x) const { return compute(x); }
+
+    value_t derivative(value_t x) const
+    {
+        return evaluateSegmentDerivative(_polynom, segment(x), x);
+    }
+
+    /**
+     * @brief   Evaluates the spline at n positions.
+     */
+    void compute(const value_t * x, value_t * out, size_t n) const
+    {
+        for (size_t j = 0; j < n; ++j) out[j] = compute(x[j]);
+    }
+
+    /**
+     * @brief   Reconstructs an owning spline of the serialized type (copies and generates).
+     */
+    std::shared_ptr<Spline<value_t>> toSpline() const
+    {
+        const size_t n{numKnots()};
+        const Intervall<value_t> i{intervall()};
+        const value_t y_0{_scalars[2]}, y_n{_scalars[3]};
+
+        std::shared_ptr<QuadraticSpline<value_t>> spline;
+        switch (type())
+        {
+        case SplineType::Quadratic:
+            if (!uniform())
+                return std::make_shared<QuadraticSpline<value_t>>(
+                    std::vector<value_t>(_knot_x, _knot_x + n),
+                    std::vector<value_t>(_knot_y, _knot_y + n),
+                    std::vector<value_t>(_polynom, _polynom + 3 * (n - 1)));
+            spline = std::make_shared<QuadraticSpline<value_t>>(n, i);
+            break;
+        case SplineType::Curvature:
+        {
+            auto c = std::make_shared<CurvatureSpline<value_t>>(n - 1, y_0, y_n, i);
+            for (size_t k = 0; k < _header->num_parameters; ++k) c->curvature(k, _parameters[k]);
+            c->generate();
+            return c;
+        }
+        case SplineType::Gradient:
+            if (_header->flags & SplineRecordHeader::FixedEnd)
+                spline = std::make_shared<GradientSpline<value_t>>(n - 2, i, y_0, y_n);
+            else
+                spline = std::make_shared<GradientSpline<value_t>>(n - 1, i, y_0);
+            break;
+        default:
+            throw std::runtime_error("SplineView: unknown spline type.");
+        }
+
+        for (size_t k = 0; k < n; ++k) spline->specify(k, _knot_y[k]);
+        spline->generate();
+        return spline;
+    }
+};
+
+/**
+ * @brief   Read-only view onto a complete spline file in memory (e.g. a memory mapped file, see
+ *          Utility::MappedFile). Construction validates the header only, records are validated on
+ *          access and evaluated in place. Opening does therefore not touch the records.
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ *
+ * @ingroup Math
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+template <typename value_t> class SplineLibraryView
+{
+    // Data
+private:
+    const char * _data;
+    size_t _size;
+    const uint64_t * _offsets;
+    size_t _count;
+
+    // Constructors
+public:
+    /**
+     * @brief   Create a view onto the file contents.
+     *
+     * @param   data    The file contents, aligned to 8 bytes.
+     * @param   size    Size in bytes.
+     */
+    SplineLibraryView(const void * data, size_t size)
+        : _data{static_cast<const char *>(data)}, _size{size}
+    {
+        const auto * header{reinterpret_cast<const SplineFileHeader *>(_data)};
+        if (size < sizeof(SplineFileHeader) ||
+            std::memcmp(header->magic, SplineFileHeader::Magic, 4) != 0)
+            throw std::runtime_error("SplineLibraryView: not a spline file.");
+        if (header->version != SplineFileHeader::CurrentVersion)
+            throw std::runtime_error("SplineLibraryView: unsupported version.");
+        if (header->value_size != sizeof(value_t))
+            throw std::runtime_error("SplineLibraryView: value type mismatch.");
+        if (reinterpret_cast<uintptr_t>(data) % 8 != 0)
+            throw std::runtime_error("SplineLibraryView: data is not aligned.");
+
+        _count = header->count;
+        _offsets = reinterpret_cast<const uint64_t *>(header + 1);
+        if (_count > (size - sizeof(SplineFileHeader)) / sizeof(uint64_t))
+            throw std::runtime_error("SplineLibraryView: truncated file.");
+    }
+
+    // Properties
+public:
+    /**
+     * @brief   Number of splines.
+     */
+    size_t size() const noexcept { return _count; }
+
+    // Methods
+public:
+    /**
+     * @brief   Returns the view onto spline i. Throws if i is out of range or the record exceeds
+     *          the file.
+     */
+    SplineView<value_t> operator[](size_t i) const
+    {
+        if (i >= _count) throw std::runtime_error("SplineLibraryView: index out of range.");
+
+        const uint64_t offset{_offsets[i]};
+        if (offset % 8 != 0 || offset > _size || _size - offset < sizeof(SplineRecordHeader))
+            throw std::runtime_error("SplineLibraryView: invalid record offset.");
+
+        const auto * record{reinterpret_cast<const SplineRecordHeader *>(_data + offset)};
+        const size_t available{(_size - offset - sizeof(SplineRecordHeader)) / sizeof(value_t)};
+        if (record->num_knots < 2 || record->num_knots > available ||
+            record->num_parameters > available ||
+            4 + 5 * record->num_knots - 3 + record->num_parameters > available)
+            throw std::runtime_error("SplineLibraryView: truncated record.");
+
+        return SplineView<value_t>(record);
+    }
+};
+
+} // namespace My::Math
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "Math/Intervall.h"
+#include "Math/QuadraticSpline.h"
+#include "Math/SplineSegment.h"
+
+namespace My::Math
+{
+
+/**
+ * @brief   Quadratic spline with a fixed number of knots which can be constructed and generated
+ *          at compile time.
+ *
+ * Generation follows QuadraticSpline::generate (vanishing derivative at the first knot) and the
+ * coefficients use the layout of Spline::polynomData. Declared as static constexpr the spline
+ * lives in read-only data and needs neither heap allocations nor work at startup:
+ *
+ * @code
+ * static constexpr StaticSpline<float, 4> EaseIn{Intervall<float>{0, 1}, {0, .1f, .4f, 1}};
+ * static_assert(EaseIn(0) == 0);
+ * @endcode
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ * @tparam  N           Number of knots (>= 2).
+ *
+ * @ingroup Math
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+template <typename value_t, size_t N> class StaticSpline
+{
+    static_assert(N >= 2, "A spline needs at least two knots.");
+
+    // Data
+private:
+    std::array<value_t, N> _knot_x{};
+    std::array<value_t, N> _knot_y{};
+    std::array<value_t, 3 * (N - 1)> _polynom{};
+    Intervall<value_t> _intervall{};
+    bool _uniform{false};
+    value_t _inv_delta{0};
+
+    // Constructors
+public:
+    /**
+     * @brief   Create and generate a spline with equally distributed knots.
+     *
+     * @param   intervall   Intervall in which the spline curve lives.
+     * @param   knot_y      y-Knot Values.
+     */
+    constexpr StaticSpline(Intervall<value_t> intervall, const std::array<value_t, N> & knot_y)
+        : _knot_y{knot_y}, _intervall{intervall}, _uniform{true},
+          _inv_delta{value_t(N - 1) / (intervall._end - intervall._start)}
+    {
+        const value_t delta{(intervall._end - intervall._start) / value_t(N - 1)};
+        for (size_t i = 0; i < N; ++i) _knot_x[i] = intervall._start + value_t(i) * delta;
+        generate();
+    }
+
+    /**
+     * @brief   Create and generate a spline.
+     *
+     * @param   knot_x  x-Knot Values (sorted).
+     * @param   knot_y  y-Knot Values.
+     */
+    constexpr StaticSpline(const std::array<value_t, N> & knot_x,
+                           const std::array<value_t, N> & knot_y)
+        : _knot_x{knot_x}, _knot_y{knot_y}, _intervall{knot_x.front(), knot_x.back()}
+    {
+        generate();
+    }
+
+    // Properties
+public:
+    constexpr Intervall<value_t> intervall() const noexcept { return _intervall; }
+
+    static constexpr size_t numKnots() noexcept { return N; }
+
+    constexpr bool uniform() const noexcept { return _uniform; }
+
+    constexpr const value_t * knotXData() const noexcept { return _knot_x.data(); }
+
+    constexpr const value_t * knotYData() const noexcept { return _knot_y.data(); }
+
+    /**
+     * @brief   The coefficients structured as: p0[0] p0[1] p0[2], p1[0] ...
+     */
+    constexpr const value_t * polynomData() const noexcept { return _polynom.data(); }
+
+    // Methods
+public:
+    /**
+     * @brief   Returns the segment containing x (clamped to the first/last segment).
+     */
+    constexpr size_t segment(value_t x) const
+    {
+        return _uniform ? findUniformSegment(_intervall._start, _inv_delta, N - 1, x)
+                        : findSegment(_knot_x.data(), N, x);
+    }
+
+    constexpr value_t compute(value_t x) const
+    {
+        return evaluateSegment(_polynom.data(), segment(x), x);
+    }
+
+    constexpr value_t operator()(value_t x) const { return compute(x); }
+
+    constexpr value_t derivative(value_t x) const
+    {
+        return evaluateSegmentDerivative(_polynom.data(), segment(x), x);
+    }
+
+    /**
+     * @brief   Evaluates the spline at n positions.
+     */
+    constexpr void compute(const value_t * x, value_t * out, size_t n) const
+    {
+        for (size_t j = 0; j < n; ++j) out[j] = compute(x[j]);
+    }
+
+    /**
+     * @brief   Creates a QuadraticSpline with the same coefficients for consumers of Spline.
+     */
+    std::shared_ptr<QuadraticSpline<value_t>> toQuadraticSpline() const
+    {
+        return std::make_shared<QuadraticSpline<value_t>>(
+            std::vector<value_t>(_knot_x.begin(), _knot_x.end()),
+            std::vector<value_t>(_knot_y.begin(), _knot_y.end()),
+            std::vector<value_t>(_polynom.begin(), _polynom.end()));
+    }
+
+private:
+    /**
+     * @brief   Same computation as QuadraticSpline::generate.
+     */
+    constexpr void generate()
+    {
+        std::array<value_t, N> d{}, w{};
+        for (size_t i = 1; i < N; ++i)
+            d[i] = 2 * (_knot_y[i] - _knot_y[i - 1]) / (_knot_x[i] - _knot_x[i - 1]);
+
+        for (size_t i = 1; i < N; ++i) w[i] = d[i] - d[i - 1] + ((i > 1) ? w[i - 2] : 0);
+
+        for (size_t i = 1; i < N; ++i)
+        {
+            const size_t id{(i - 1) * 3};
+            const value_t x{_knot_x[i - 1]};
+            _polynom[id] = 0.5 * (w[i] - w[i - 1]) / (_knot_x[i] - x);
+            _polynom[id + 1] = w[i - 1] - 2 * _polynom[id] * x;
+            _polynom[id + 2] = _polynom[id] * x * x - w[i - 1] * x + _knot_y[i - 1];
+        }
+    }
+};
+
+} // namespace My::Math
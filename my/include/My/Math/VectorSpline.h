@@ -0,0 +1,222 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "Math/Intervall.h"
+#include "Math/QuadraticSpline.h"
+#include "Math/SplineSegment.h"
+#include "Utility/AlignedAllocator.h"
+
+namespace My::Math
+{
+
+/**
+ * @brief   Vector valued quadratic spline (e.g. a 3D path or a color ramp) whose channels share
+ *          one knot vector.
+ *
+ * All channels are evaluated with a single segment lookup. Knot values and coefficients are
+ * interleaved per channel ([knot][channel] and [segment][a, b][channel]) so one evaluation reads
+ * contiguous memory. The coefficients are relative to the segment start, the constant coefficient
+ * of segment i is the knot value y_i.
+ *
+ * @tparam  value_t     The floating point type to operate on.
+ * @tparam  Channels    Number of channels.
+ *
+ * @ingroup Math
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+template <typename value_t, size_t Channels> class VectorSpline
+{
+public:
+    using point_t = std::array<value_t, Channels>;
+
+    // Data
+private:
+    std::vector<value_t> _knot_x;
+    Utility::AlignedVector<value_t> _knot_y;       // [knot][channel]
+    Utility::AlignedVector<value_t> _coefficients; // [segment][a, b][channel]
+    point_t _slope{};                              // derivative at the first knot
+    Intervall<value_t> _intervall;
+    bool _uniform{true};
+    value_t _inv_delta{0};
+
+    // Constructors
+public:
+    /**
+     * @brief   Create new instance with equally distributed knots.
+     *
+     * @param   num_knots   Number of knots.
+     * @param   intervall   Intervall in which the spline curve lives.
+     */
+    VectorSpline(size_t num_knots, Intervall<value_t> intervall)
+        : _knot_x(num_knots), _knot_y(num_knots * Channels),
+          _coefficients((num_knots - 1) * 2 * Channels), _intervall{intervall},
+          _inv_delta{value_t(num_knots - 1) / (intervall._end - intervall._start)}
+    {
+        const value_t delta{(_intervall._end - _intervall._start) / value_t(num_knots - 1)};
+        for (size_t i = 0; i < num_knots; ++i) _knot_x[i] = _intervall._start + value_t(i) * delta;
+    }
+
+    /**
+     * @brief   Create new instance.
+     *
+     * @param   knot_x   x-Knot Values (sorted).
+     */
+    VectorSpline(std::vector<value_t> knot_x)
+        : _knot_x(std::move(knot_x)), _knot_y(_knot_x.size() * Channels),
+          _coefficients((_knot_x.size() - 1) * 2 * Channels),
+          _intervall{_knot_x.front(), _knot_x.back()}, _uniform{false}
+    {}
+
+    // Properties
+public:
+    Intervall<value_t> intervall() const noexcept { return _intervall; }
+
+    size_t numKnots() const noexcept { return _knot_x.size(); }
+
+    bool uniform() const noexcept { return _uniform; }
+
+    const std::vector<value_t> & X() const { return _knot_x; }
+
+    /**
+     * @brief   Access the knot values structured as: y0[0] .. y0[Channels - 1], y1[0] ...
+     */
+    const value_t * knotYData() const noexcept { return _knot_y.data(); }
+
+    /**
+     * @brief   Access the coefficients relative to the segment start structured as
+     *          [segment][a, b][channel], i.e. a0[0] .. a0[Channels - 1], b0[0] ...
+     */
+    const value_t * coefficientData() const noexcept { return _coefficients.data(); }
+
+    point_t knot(size_t knot) const
+    {
+        point_t p;
+        for (size_t c = 0; c < Channels; ++c) p[c] = _knot_y[knot * Channels + c];
+        return p;
+    }
+
+    /**
+     * @brief   Specify a single channel of a knot.
+     */
+    void specify(size_t knot, size_t channel, value_t value)
+    {
+        _knot_y[knot * Channels + channel] = value;
+    }
+
+    /**
+     * @brief   Specify all channels of a knot.
+     */
+    void specify(size_t knot, const point_t & value)
+    {
+        for (size_t c = 0; c < Channels; ++c) _knot_y[knot * Channels + c] = value[c];
+    }
+
+    /**
+     * @brief   Specify the derivative at the first knot (default 0 like QuadraticSpline).
+     */
+    void specifyDerivative(const point_t & slope) { _slope = slope; }
+
+    // Methods
+public:
+    /**
+     * @brief   Computes the coefficients of all channels.
+     */
+    void generate()
+    {
+        point_t w_prev{_slope};
+        for (size_t i = 0; i + 1 < _knot_x.size(); ++i)
+        {
+            const value_t h{_knot_x[i + 1] - _knot_x[i]}, inv_h{value_t(1) / h};
+            const value_t * y{&_knot_y[i * Channels]};
+            value_t * p{&_coefficients[i * 2 * Channels]};
+            for (size_t c = 0; c < Channels; ++c)
+            {
+                const value_t w{2 * (y[Channels + c] - y[c]) * inv_h - w_prev[c]};
+                p[c] = (w - w_prev[c]) * inv_h / 2; // a
+                p[Channels + c] = w_prev[c];        // b
+                w_prev[c] = w;
+            }
+        }
+    }
+
+    /**
+     * @brief   Returns the segment containing x (clamped to the first/last segment).
+     */
+    size_t segment(value_t x) const
+    {
+        return _uniform
+                   ? findUniformSegment(_intervall._start, _inv_delta, _knot_x.size() - 1, x)
+                   : findSegment(_knot_x.data(), _knot_x.size(), x);
+    }
+
+    point_t compute(value_t x) const
+    {
+        point_t r;
+        evaluate(segment(x), x, r.data());
+        return r;
+    }
+
+    point_t operator()(value_t x) const { return compute(x); }
+
+    point_t derivative(value_t x) const
+    {
+        point_t r;
+        evaluateDerivative(segment(x), x, r.data());
+        return r;
+    }
+
+    /**
+     * @brief   Evaluates all channels at n positions.
+     */
+    void compute(const value_t * x, point_t * out, size_t n) const
+    {
+        for (size_t j = 0; j < n; ++j) evaluate(segment(x[j]), x[j], out[j].data());
+    }
+
+    /**
+     * @brief   Evaluates the derivative of all channels at n positions.
+     */
+    void derivative(const value_t * x, point_t * out, size_t n) const
+    {
+        for (size_t j = 0; j < n; ++j) evaluateDerivative(segment(x[j]), x[j], out[j].data());
+    }
+
+    /**
+     * @brief   Extracts a single channel as QuadraticSpline (same coefficients).
+     */
+    std::shared_ptr<QuadraticSpline<value_t>> channel(size_t channel) const
+    {
+        const size_t n{_knot_x.size()};
+        std::vector<value_t> knot_y(n), polynom(3 * (n - 1));
+        for (size_t i = 0; i < n; ++i) knot_y[i] = _knot_y[i * Channels + channel];
+        for (size_t i = 0; i + 1 < n; ++i)
+        {
+            const value_t a{_coefficients[i * 2 * Channels + channel]},
+                b{_coefficients[i * 2 * Channels + Channels + channel]}, x_i{_knot_x[i]};
+            polynom[3 * i] = a;
+            polynom[3 * i + 1] = b - 2 * a * x_i;
+            polynom[3 * i + 2] = (a * x_i - b) * x_i + knot_y[i];
+        }
+        return std::make_shared<QuadraticSpline<value_t>>(_knot_x, knot_y, polynom);
+    }
+
+private:
+    void evaluate(size_t i, value_t x, value_t * out) const
+    {
+        const value_t t{x - _knot_x[i]};
+        const value_t *p{&_coefficients[i * 2 * Channels]}, *y{&_knot_y[i * Channels]};
+        for (size_t c = 0; c < Channels; ++c) out[c] = (p[c] * t + p[Channels + c]) * t + y[c];
+    }
+
+    void evaluateDerivative(size_t i, value_t x, value_t * out) const
+    {
+        const value_t t{x - _knot_x[i]};
+        const value_t * p{&_coefficients[i * 2 * Channels]};
+        for (size_t c = 0; c < Channels; ++c) out[c] = 2 * p[c] * t + p[Channels + c];
+    }
+};
+
+} // namespace My::Math
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "pch.h"
+
+namespace My::Utility
+{
+
+/**
+ * @brief   Allocator returning memory aligned to Alignment bytes (e.g. a cache line). Allows
+ *          aligned vector loads on std::vector data.
+ *
+ * @tparam  value_t     The element type.
+ * @tparam  Alignment   The alignment in bytes (power of two).
+ *
+ * @ingroup Utility
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+template <typename value_t, size_t Alignment = 64> class AlignedAllocator
+{
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two.");
+
+public:
+    using value_type = value_t;
+
+    template <typename other_t> struct rebind
+    {
+        using other = AlignedAllocator<other_t, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename other_t>
+    AlignedAllocator(const AlignedAllocator<other_t, Alignment> &) noexcept
+    {}
+
+    value_t * allocate(size_t n)
+    {
+        return static_cast<value_t *>(
+            ::operator new(n * sizeof(value_t), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(value_t * p, size_t) noexcept
+    {
+        ::operator delete(p, std::align_val_t{Alignment});
+    }
+
+    template <typename other_t> bool operator==(const AlignedAllocator<other_t, Alignment> &) const
+    {
+        return true;
+    }
+
+    template <typename other_t> bool operator!=(const AlignedAllocator<other_t, Alignment> &) const
+    {
+        return false;
+    }
+};
+
+/**
+ * @brief   std::vector with cache line aligned storage.
+ *
+ * @ingroup Utility
+ */
+template <typename value_t, size_t Alignment = 64>
+using AlignedVector = std::vector<value_t, AlignedAllocator<value_t, Alignment>>;
+
+} // namespace My::Utility
@@ -0,0 +1,480 @@
+#pragma once
+
+#include "pch.h"
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+
+#include "My/Utility/Task.h"
+
+namespace My::Utility
+{
+
+/**
+ * @brief   Unit of work: calls Run(Data, Begin, End). Coroutines are resumed through the same
+ *          interface, so jobs never allocate.
+ *
+ * @ingroup Utility
+ */
+struct Job
+{
+    void (*Run)(void * data, size_t begin, size_t end);
+    void * Data;
+    size_t Begin;
+    size_t End;
+    const void * Tag{nullptr}; // set by JobSystem::Push, see JobSystem::Tag
+};
+
+/**
+ * @brief   Job deque of one thread. The owner pushes and pops at the back (LIFO, cache friendly),
+ *          other threads steal from the front (the oldest, usually largest jobs).
+ *
+ * @ingroup Utility
+ */
+class alignas(64) JobQueue
+{
+private:
+    std::mutex _mutex;
+    std::deque<Job> _jobs;
+    std::atomic<size_t> _size{0};
+
+public:
+    void Push(const Job & job)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _jobs.push_back(job);
+        _size.store(_jobs.size(), std::memory_order_relaxed);
+    }
+
+    bool Pop(Job & job)
+    {
+        if (Empty()) return false;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_jobs.empty()) return false;
+        job = _jobs.back();
+        _jobs.pop_back();
+        _size.store(_jobs.size(), std::memory_order_relaxed);
+        return true;
+    }
+
+    bool Steal(Job & job)
+    {
+        if (Empty()) return false;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_jobs.empty()) return false;
+        job = _jobs.front();
+        _jobs.pop_front();
+        _size.store(_jobs.size(), std::memory_order_relaxed);
+        return true;
+    }
+
+    bool Empty() const { return _size.load(std::memory_order_relaxed) == 0; }
+};
+
+/**
+ * @brief   Signal for coroutines, e.g. completion of an I/O request. Set may be called from any
+ *          thread (e.g. a completion callback) and resumes all awaiting coroutines, on the job
+ *          system if one was given, else on the calling thread. Awaiting a set event does not
+ *          suspend.
+ *
+ * @ingroup Utility
+ */
+class CompletionEvent
+{
+private:
+    static inline char SetTag{0}; // its address marks the set state
+
+    struct Awaiter
+    {
+        CompletionEvent & Event;
+        std::coroutine_handle<> Handle{};
+        Awaiter * Next{nullptr};
+
+        bool await_ready() const noexcept { return Event.IsSet(); }
+
+        bool await_suspend(std::coroutine_handle<> handle) noexcept
+        {
+            Handle = handle;
+            void * state = Event._state.load();
+            do
+            {
+                if (state == &SetTag) return false;
+                Next = static_cast<Awaiter *>(state);
+            } while (!Event._state.compare_exchange_weak(state, this));
+            return true;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    JobSystem * _jobs;
+    std::atomic<void *> _state{nullptr}; // &SetTag or the list of waiting awaiters
+
+public:
+    explicit CompletionEvent(JobSystem * jobs = nullptr) : _jobs{jobs} {}
+
+    CompletionEvent(const CompletionEvent &) = delete;
+
+    CompletionEvent & operator=(const CompletionEvent &) = delete;
+
+    bool IsSet() const { return _state.load() == &SetTag; }
+
+    inline void Set();
+
+    /**
+     * @brief   Makes the event awaitable again, must not race with awaiting coroutines.
+     */
+    void Reset()
+    {
+        void * set = &SetTag;
+        _state.compare_exchange_strong(set, nullptr);
+    }
+
+    Awaiter operator co_await() noexcept { return Awaiter{*this}; }
+};
+
+/**
+ * @brief   Work-stealing thread pool shared by loaders, solvers and systems.
+ *
+ * Every thread has its own JobQueue, idle workers steal from the others. The thread constructing
+ * the job system is the main thread: it owns queue 0 and runs jobs while it waits (Wait,
+ * ParallelFor). The coroutines that asked for main thread affinity run only in RunMainThreadJobs,
+ * e.g. once per frame outside of the system updates. Without workers (one thread) the queued jobs
+ * run there as well.
+ *
+ * @ingroup Utility
+ */
+class JobSystem
+{
+private:
+    static constexpr size_t None{SIZE_MAX};
+
+    static inline thread_local JobSystem * CurrentSystem{nullptr};
+    static inline thread_local size_t CurrentQueue{None};
+    static inline thread_local const void * CurrentTag{nullptr};
+
+    std::vector<std::unique_ptr<JobQueue>> _queues; // 0 = main thread
+    std::vector<std::thread> _workers;
+    std::thread::id _main_thread;
+
+    std::mutex _main_mutex;
+    std::vector<std::coroutine_handle<>> _main_jobs;
+    bool _in_main_jobs{false}; // RunMainThreadJobs is running
+
+    std::atomic<size_t> _queued{0}; // jobs in all queues
+    std::atomic<size_t> _next_queue{0};
+    std::atomic<size_t> _sleeping{0};
+    std::atomic<bool> _stop{false};
+    std::mutex _sleep_mutex;
+    std::condition_variable _wake;
+
+    // Constructors //
+public:
+    /**
+     * @param   num_threads     Number of threads including the main thread.
+     */
+    explicit JobSystem(size_t num_threads = std::thread::hardware_concurrency())
+        : _main_thread{std::this_thread::get_id()}
+    {
+        num_threads = std::max<size_t>(1, num_threads);
+        for (size_t i = 0; i < num_threads; ++i) _queues.push_back(std::make_unique<JobQueue>());
+
+        CurrentSystem = this;
+        CurrentQueue = 0;
+        for (size_t i = 1; i < num_threads; ++i) _workers.emplace_back([this, i] { Work(i); });
+    }
+
+    JobSystem(const JobSystem &) = delete;
+
+    JobSystem & operator=(const JobSystem &) = delete;
+
+    ~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_sleep_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+        for (auto & worker : _workers) worker.join();
+
+        if (CurrentSystem == this) CurrentSystem = nullptr;
+    }
+
+    // Properties //
+public:
+    /**
+     * @brief   Number of threads including the main thread.
+     */
+    size_t NumThreads() const { return _queues.size(); }
+
+    bool IsMainThread() const { return std::this_thread::get_id() == _main_thread; }
+
+    /**
+     * @brief   Opaque tag of the running job, e.g. the system it belongs to. Jobs inherit the tag
+     *          of the thread pushing them, so the blocks of a ParallelFor carry the tag of the
+     *          caller.
+     */
+    static const void * Tag() { return CurrentTag; }
+
+    static void SetTag(const void * tag) { CurrentTag = tag; }
+
+    // Jobs //
+public:
+    /**
+     * @brief   Queues the job on the calling worker's queue, jobs pushed by other threads are
+     *          distributed round robin.
+     */
+    void Push(Job job)
+    {
+        job.Tag = CurrentTag;
+
+        const size_t queue = CurrentSystem == this
+                                 ? CurrentQueue
+                                 : _next_queue.fetch_add(1, std::memory_order_relaxed) %
+                                       _queues.size();
+        _queues[queue]->Push(job);
+
+        _queued.fetch_add(1);
+        if (_sleeping.load() > 0)
+        {
+            { std::lock_guard<std::mutex> lock(_sleep_mutex); }
+            _wake.notify_one();
+        }
+    }
+
+    void Push(std::coroutine_handle<> handle) { Push(Job{&Resume, handle.address(), 0, 0}); }
+
+    /**
+     * @brief   Runs one job of the own queue or stolen from another thread.
+     *
+     * @return  False if there was no job.
+     */
+    bool RunOne()
+    {
+        Job job;
+        if (!Take(job)) return false;
+
+        const void * tag = std::exchange(CurrentTag, job.Tag);
+        job.Run(job.Data, job.Begin, job.End);
+        CurrentTag = tag;
+        return true;
+    }
+
+    /**
+     * @brief   Resumes the coroutines waiting for the main thread (see MainThread). Call regularly
+     *          on the main thread, e.g. once per frame. Without workers it first runs the jobs
+     *          queued so far.
+     */
+    void RunMainThreadJobs()
+    {
+        assert(IsMainThread());
+        const bool nested = std::exchange(_in_main_jobs, true);
+
+        if (_workers.empty())
+            for (size_t n = _queued.load(); n > 0 && RunOne(); --n) {}
+
+        std::vector<std::coroutine_handle<>> jobs;
+        {
+            std::lock_guard<std::mutex> lock(_main_mutex);
+            jobs.swap(_main_jobs);
+        }
+        for (const auto handle : jobs) handle.resume();
+
+        _in_main_jobs = nested;
+    }
+
+    // Coroutines //
+public:
+    /**
+     * @brief   co_await jobs.Schedule() continues the coroutine on a worker.
+     */
+    auto Schedule()
+    {
+        struct Awaiter
+        {
+            JobSystem & Jobs;
+
+            bool await_ready() const noexcept { return false; }
+
+            void await_suspend(std::coroutine_handle<> handle) { Jobs.Push(handle); }
+
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{*this};
+    }
+
+    /**
+     * @brief   co_await jobs.MainThread() continues the coroutine in the next RunMainThreadJobs, or
+     *          immediately if it runs within RunMainThreadJobs already. A job the main thread runs
+     *          while waiting (e.g. in a ParallelFor of a system) does not count, it is suspended.
+     */
+    auto MainThread()
+    {
+        struct Awaiter
+        {
+            JobSystem & Jobs;
+
+            bool await_ready() const noexcept { return Jobs.IsMainThread() && Jobs._in_main_jobs; }
+
+            void await_suspend(std::coroutine_handle<> handle)
+            {
+                std::lock_guard<std::mutex> lock(Jobs._main_mutex);
+                Jobs._main_jobs.push_back(handle);
+            }
+
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{*this};
+    }
+
+    /**
+     * @brief   Starts the task on a worker. It can be awaited or waited for later.
+     */
+    template <typename value_t> void Start(Task<value_t> & task)
+    {
+        auto & promise = task._handle.promise();
+        if (promise._started) return;
+
+        promise._started = true;
+        Push(task._handle);
+    }
+
+    /**
+     * @brief   Starts the task if necessary and blocks until it finished. The waiting thread runs
+     *          other jobs meanwhile. The main thread must not wait for a task awaiting MainThread,
+     *          the task would resume only in the next RunMainThreadJobs.
+     *
+     * @return  The result of the task, rethrows its exception.
+     */
+    template <typename value_t> value_t Wait(Task<value_t> & task)
+    {
+        Start(task);
+        while (!task.Finished()) Help();
+        return task._handle.promise().Result();
+    }
+
+    // Parallel Loops //
+public:
+    /**
+     * @brief   Calls f(block_begin, block_end) for blocks covering [begin, end) on all threads and
+     *          returns when all blocks are done. f must not throw.
+     *
+     * Ranges are split lazily: a thread offers the upper half of its range for stealing whenever
+     * its own queue ran empty, and otherwise processes grain elements at a time. So balanced loops
+     * split about once per thread, while imbalanced ones keep splitting where work remains.
+     *
+     * @param   grain   Minimum block size, SIZE_MAX runs the loop on the calling thread.
+     */
+    template <typename func_t>
+    void ParallelFor(size_t begin, size_t end, func_t && f, size_t grain = 1)
+    {
+        if (begin >= end) return;
+
+        Range<std::remove_reference_t<func_t>> range{f, *this, std::max<size_t>(1, grain),
+                                                    end - begin};
+        RunRange<decltype(range)>(&range, begin, end);
+        while (range.Remaining.load(std::memory_order_acquire) != 0) Help();
+    }
+
+private:
+    template <typename func_t> struct Range
+    {
+        func_t & F;
+        JobSystem & Jobs;
+        size_t Grain;
+        std::atomic<size_t> Remaining;
+    };
+
+    template <typename range_t> static void RunRange(void * data, size_t begin, size_t end)
+    {
+        range_t & range = *static_cast<range_t *>(data);
+        while (begin < end)
+        {
+            if (end - begin > range.Grain && range.Jobs.LocalQueueEmpty())
+            {
+                const size_t middle = begin + (end - begin) / 2;
+                range.Jobs.Push(Job{&RunRange<range_t>, data, middle, end});
+                end = middle;
+                continue;
+            }
+
+            const size_t stop = begin + std::min(range.Grain, end - begin);
+            range.F(begin, stop);
+            range.Remaining.fetch_sub(stop - begin, std::memory_order_acq_rel);
+            begin = stop;
+        }
+    }
+
+    static void Resume(void * data, size_t, size_t)
+    {
+        std::coroutine_handle<>::from_address(data).resume();
+    }
+
+    bool LocalQueueEmpty() const
+    {
+        return CurrentSystem == this ? _queues[CurrentQueue]->Empty() : _queued.load() == 0;
+    }
+
+    bool Take(Job & job)
+    {
+        const size_t n = _queues.size();
+        const size_t self = CurrentSystem == this ? CurrentQueue : 0;
+        if (CurrentSystem == this && _queues[self]->Pop(job))
+        {
+            _queued.fetch_sub(1);
+            return true;
+        }
+
+        for (size_t k = 1; k <= n; ++k)
+        {
+            if (_queues[(self + k) % n]->Steal(job))
+            {
+                _queued.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Help()
+    {
+        if (!RunOne()) std::this_thread::yield();
+    }
+
+    void Work(size_t queue)
+    {
+        CurrentSystem = this;
+        CurrentQueue = queue;
+
+        while (!_stop.load())
+        {
+            if (RunOne()) continue;
+
+            std::unique_lock<std::mutex> lock(_sleep_mutex);
+            ++_sleeping;
+            _wake.wait(lock, [this] { return _stop.load() || _queued.load() > 0; });
+            --_sleeping;
+        }
+    }
+};
+
+inline void CompletionEvent::Set()
+{
+    void * state = _state.exchange(&SetTag);
+    if (state == &SetTag) return;
+
+    for (Awaiter * awaiter = static_cast<Awaiter *>(state); awaiter;)
+    {
+        Awaiter * next = awaiter->Next; // the awaiter dies with its coroutine
+        if (_jobs)
+            _jobs->Push(awaiter->Handle);
+        else
+            awaiter->Handle.resume();
+        awaiter = next;
+    }
+}
+
+} // namespace My::Utility
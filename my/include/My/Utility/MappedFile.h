@@ -0,0 +1,59 @@
+#pragma once
+
+#include "pch.h"
+
+namespace My::Utility
+{
+
+namespace _implementation
+{
+
+/**
+ * @brief   Read-only memory mapping of a file. The contents are paged in on access, nothing is
+ *          copied (see Math::SplineLibraryView).
+ *
+ * @ingroup Utility
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+class MappedFile
+{
+    // Data
+private:
+    HANDLE _file{INVALID_HANDLE_VALUE};
+    HANDLE _mapping{nullptr};
+    const void * _data{nullptr};
+    size_t _size{0};
+
+    // Constructors
+public:
+    MappedFile(const std::wstring & filename);
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile(MappedFile && o) noexcept;
+
+    ~MappedFile();
+
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    MappedFile & operator=(MappedFile && o) noexcept;
+
+    // Properties
+public:
+    /**
+     * @brief   The mapped contents (page aligned).
+     */
+    const void * Data() const noexcept { return _data; }
+
+    size_t Size() const noexcept { return _size; }
+
+    // Methods
+private:
+    void Close() noexcept;
+};
+
+} // namespace _implementation
+
+using _implementation::MappedFile;
+
+} // namespace My::Utility
@@ -13,6 +13,11 @@ namespace _implementation
 class MeshLoader
 {
 public:
+    /**
+     * @brief   Loads the file, creates a root entity with one child entity per object of the file.
+     *
+     * @return  The root entity.
+     */
     static EntityReference Load(std::wstring filename, EntityManager & entity_manager,
                                 ComponentManager & component_manager)
     {
@@ -0,0 +1,347 @@
+#pragma once
+
+#include "pch.h"
+
+#include "My/Engine/MeshComponent.h"
+#include "My/Math/Spline.h"
+#include "My/Math/VectorSpline.h"
+
+namespace My::Utility
+{
+
+namespace _implementation
+{
+
+using namespace My::Engine;
+
+enum class TessellationShape
+{
+    Ribbon, // flat band, two vertices per sample
+    Tube    // closed tube, TubeSides + 1 vertices per sample (the seam is duplicated for the UVs)
+};
+
+struct TessellationSettings
+{
+    TessellationShape Shape{TessellationShape::Ribbon};
+    float Width{0.01f};  // ribbon width respectively tube diameter
+    size_t TubeSides{8}; // vertices per ring of a tube
+    glm::vec3 Up{0.f, 0.f, 1.f};
+
+    float Tolerance{0.001f};          // maximum absolute chordal error
+    float PixelTolerance{0.f};        // if > 0 the chordal error is bounded in pixels instead
+    float PixelsPerRadian{1000.f};    // resolution of the view for PixelTolerance
+    glm::vec3 Eye{0.f, 0.f, 0.f};     // viewer position for PixelTolerance
+    size_t MaxSamplesPerSegment{256}; //
+};
+
+/**
+ * @brief   Describes which part of the mesh was written by SplineTessellator::Tessellate.
+ */
+struct TessellationUpdate
+{
+    size_t FirstVertex{0};
+    size_t NumVertices{0};
+    bool TopologyChanged{false}; // indices (and vertex count) were rebuilt
+
+    bool Empty() const { return NumVertices == 0 && !TopologyChanged; }
+};
+
+/**
+ * @brief   Converts splines into ribbon or tube geometry of a MeshComponent.
+ *
+ * Each polynomial segment P(t) = A t^2 + B t + C is subdivided uniformly into the minimal number of
+ * pieces n meeting the chordal error |A| (h / n)^2 / 4 <= tolerance, i.e. flat segments get a
+ * single piece. With PixelTolerance set, the tolerance is scaled with the distance of the segment
+ * to Eye (screen-space error). Neighbouring segments share their boundary samples, the mesh is
+ * indexed without duplicate vertices.
+ *
+ * The tessellator remembers the segments of the last call. Subsequent calls for the same mesh only
+ * rewrite the vertices of changed segments and keep the indices if no sample count changed (see
+ * TessellationUpdate). Call Invalidate() after changing the Settings.
+ *
+ * Scalar splines are placed in the xy-plane as (x, s(x), 0), VectorSpline<value_t, 3> are used as
+ * 3D paths. The u texture coordinate runs from 0 to 1 along the spline intervall.
+ *
+ * @ingroup Utility
+ * @author  Ronja Schnur (rschnur@students.uni-mainz.de)
+ */
+class SplineTessellator
+{
+    // Data
+public:
+    TessellationSettings Settings;
+
+private:
+    struct Segment
+    {
+        glm::vec3 A, B, C; // P(t) = A t^2 + B t + C, t in [0, H]
+        float X0, H;
+        size_t Pieces;
+    };
+
+    std::vector<Segment> _segments;
+    std::vector<size_t> _first_sample; // per segment
+    float _u_start{0.f}, _u_scale{1.f};
+
+    // Constructors
+public:
+    SplineTessellator(TessellationSettings settings = {}) : Settings{settings} {}
+
+    // Methods
+public:
+    /**
+     * @brief   Tessellates a generated scalar spline into mesh.
+     */
+    template <typename value_t>
+    TessellationUpdate Tessellate(const Math::Spline<value_t> & spline, MeshComponent & mesh)
+    {
+        const value_t *x{spline.knotXData()}, *p{spline.polynomData()};
+        std::vector<Segment> segments(spline.numKnots() - 1);
+        for (size_t i = 0; i < segments.size(); ++i)
+        {
+            // local coefficients (see LocalQuadraticSpline)
+            const value_t a{p[3 * i]}, b{2 * p[3 * i] * x[i] + p[3 * i + 1]},
+                c{(p[3 * i] * x[i] + p[3 * i + 1]) * x[i] + p[3 * i + 2]};
+            segments[i] = {glm::vec3{0.f, float(a), 0.f}, glm::vec3{1.f, float(b), 0.f},
+                           glm::vec3{float(x[i]), float(c), 0.f}, float(x[i]),
+                           float(x[i + 1] - x[i]), 0};
+        }
+        return Apply(segments, mesh);
+    }
+
+    /**
+     * @brief   Tessellates a generated 3D path into mesh.
+     */
+    template <typename value_t>
+    TessellationUpdate Tessellate(const Math::VectorSpline<value_t, 3> & spline,
+                                  MeshComponent & mesh)
+    {
+        const auto & x{spline.X()};
+        const value_t *y{spline.knotYData()}, *p{spline.coefficientData()};
+        std::vector<Segment> segments(spline.numKnots() - 1);
+        for (size_t i = 0; i < segments.size(); ++i)
+        {
+            const value_t *a{p + 6 * i}, *b{p + 6 * i + 3}, *c{y + 3 * i};
+            segments[i] = {glm::vec3{float(a[0]), float(a[1]), float(a[2])},
+                           glm::vec3{float(b[0]), float(b[1]), float(b[2])},
+                           glm::vec3{float(c[0]), float(c[1]), float(c[2])}, float(x[i]),
+                           float(x[i + 1] - x[i]), 0};
+        }
+        return Apply(segments, mesh);
+    }
+
+    /**
+     * @brief   Forces a complete rebuild with the next call.
+     */
+    void Invalidate()
+    {
+        _segments.clear();
+        _first_sample.clear();
+    }
+
+private:
+    size_t TubeSides() const { return std::max<size_t>(Settings.TubeSides, 3); }
+
+    /**
+     * @brief   Vertices per sample.
+     */
+    size_t RingSize() const
+    {
+        if (Settings.Shape == TessellationShape::Ribbon) return 2;
+        return TubeSides() + 1;
+    }
+
+    size_t Pieces(const Segment & s) const
+    {
+        float tolerance{Settings.Tolerance};
+        if (Settings.PixelTolerance > 0.f)
+        {
+            const glm::vec3 mid{(s.A * (s.H / 2) + s.B) * (s.H / 2) + s.C};
+            tolerance = Settings.PixelTolerance * glm::length(mid - Settings.Eye) /
+                        Settings.PixelsPerRadian;
+        }
+
+        const float curvature{glm::length(s.A)};
+        if (!(curvature > 0.f)) return 1;
+        if (!(tolerance > 0.f)) return Settings.MaxSamplesPerSegment;
+
+        const float n{std::ceil(s.H * std::sqrt(curvature / (4 * tolerance)))};
+        return std::clamp<size_t>(size_t(n), 1, std::max<size_t>(Settings.MaxSamplesPerSegment, 1));
+    }
+
+    static bool Equal(const Segment & a, const Segment & b)
+    {
+        return a.A == b.A && a.B == b.B && a.C == b.C && a.X0 == b.X0 && a.H == b.H;
+    }
+
+    TessellationUpdate Apply(std::vector<Segment> & segments, MeshComponent & mesh)
+    {
+        if (segments.empty()) return {};
+
+        const size_t ring{RingSize()};
+        const float u_start{segments.front().X0};
+        const float length{segments.back().X0 + segments.back().H - u_start};
+        const float u_scale{length > 0.f ? 1.f / length : 0.f};
+
+        // a moved first or last knot remaps the texture coordinates of all segments
+        const bool remap{u_start != _u_start || u_scale != _u_scale};
+        _u_start = u_start;
+        _u_scale = u_scale;
+
+        // mesh does not belong to the last call
+        const size_t old_samples{_first_sample.empty() ? 0
+                                                       : _first_sample.back() +
+                                                             _segments.back().Pieces + 1};
+        if (mesh.Vertices.size() != old_samples * ring) Invalidate();
+
+        bool topology{segments.size() != _segments.size()};
+        std::vector<bool> changed(segments.size(), true);
+        for (size_t i = 0; i < segments.size(); ++i)
+        {
+            const bool known{i < _segments.size() && Equal(segments[i], _segments[i])};
+            segments[i].Pieces = known ? _segments[i].Pieces : Pieces(segments[i]);
+            changed[i] = !known || remap;
+            topology = topology || segments[i].Pieces != _segments[i].Pieces;
+        }
+
+        std::vector<size_t> first_sample(segments.size());
+        for (size_t i = 1; i < segments.size(); ++i)
+            first_sample[i] = first_sample[i - 1] + segments[i - 1].Pieces;
+        const size_t num_samples{first_sample.back() + segments.back().Pieces + 1};
+
+        TessellationUpdate update;
+        if (topology)
+        {
+            std::vector<glm::vec3> vertices(num_samples * ring), normals(num_samples * ring);
+            std::vector<glm::vec2> uvs(num_samples * ring);
+            for (size_t i = 0; i < segments.size(); ++i)
+            {
+                const size_t owned{segments[i].Pieces + (i + 1 == segments.size() ? 1 : 0)};
+                const size_t first{first_sample[i] * ring}, count{owned * ring};
+                if (!changed[i] && i + 1 < segments.size() && i + 1 < _segments.size())
+                {
+                    // unchanged segment, move its vertices
+                    const size_t old_first{_first_sample[i] * ring};
+                    std::copy_n(mesh.Vertices.begin() + old_first, count, vertices.begin() + first);
+                    std::copy_n(mesh.Normals.begin() + old_first, count, normals.begin() + first);
+                    std::copy_n(mesh.UVs.begin() + old_first, count, uvs.begin() + first);
+                }
+                else
+                    WriteSegment(segments[i], owned, first_sample[i], vertices, normals, uvs);
+            }
+            mesh.Vertices = std::move(vertices);
+            mesh.Normals = std::move(normals);
+            mesh.UVs = std::move(uvs);
+            WriteIndices(num_samples, mesh.Indices);
+            mesh.DoubleSided = Settings.Shape == TessellationShape::Ribbon;
+
+            update = {0, mesh.Vertices.size(), true};
+        }
+        else
+        {
+            size_t begin{mesh.Vertices.size()}, end{0};
+            for (size_t i = 0; i < segments.size(); ++i)
+            {
+                if (!changed[i]) continue;
+                const size_t owned{segments[i].Pieces + (i + 1 == segments.size() ? 1 : 0)};
+                WriteSegment(segments[i], owned, first_sample[i], mesh.Vertices, mesh.Normals,
+                             mesh.UVs);
+                begin = std::min(begin, first_sample[i] * ring);
+                end = std::max(end, (first_sample[i] + owned) * ring);
+            }
+            if (begin < end) update = {begin, end - begin, false};
+        }
+
+        _segments = std::move(segments);
+        _first_sample = std::move(first_sample);
+        return update;
+    }
+
+    /**
+     * @brief   Writes the first count samples of the segment starting at sample first.
+     */
+    void WriteSegment(const Segment & s, size_t count, size_t first,
+                      std::vector<glm::vec3> & vertices, std::vector<glm::vec3> & normals,
+                      std::vector<glm::vec2> & uvs) const
+    {
+        const size_t ring{RingSize()};
+        const float radius{Settings.Width / 2};
+        for (size_t k = 0; k < count; ++k)
+        {
+            const float t{s.H * float(k) / float(s.Pieces)};
+            const glm::vec3 position{(s.A * t + s.B) * t + s.C};
+
+            // frame from the tangent and the up vector (local, independent of other segments)
+            // the direction of a resting point (e.g. the spline start) is given by A
+            glm::vec3 tangent{2.f * s.A * t + s.B};
+            if (!(glm::length(tangent) > 1e-6f)) tangent = s.A;
+            tangent = glm::length(tangent) > 0.f ? glm::normalize(tangent) : glm::vec3{1, 0, 0};
+            glm::vec3 side{glm::cross(tangent, Settings.Up)};
+            if (glm::length(side) < 1e-6f) side = glm::cross(tangent, glm::vec3{1.f, 0.f, 0.f});
+            if (glm::length(side) < 1e-6f) side = glm::cross(tangent, glm::vec3{0.f, 1.f, 0.f});
+            side = glm::normalize(side);
+            const glm::vec3 normal{glm::cross(side, tangent)};
+
+            const float u{(s.X0 + t - _u_start) * _u_scale};
+            const size_t v{(first + k) * ring};
+            if (Settings.Shape == TessellationShape::Ribbon)
+            {
+                vertices[v] = position - side * radius;
+                vertices[v + 1] = position + side * radius;
+                normals[v] = normals[v + 1] = normal;
+                uvs[v] = {u, 0.f};
+                uvs[v + 1] = {u, 1.f};
+            }
+            else
+            {
+                // the last vertex repeats the first one at v = 1
+                const size_t sides{TubeSides()};
+                for (size_t r = 0; r < ring; ++r)
+                {
+                    const float angle{6.2831853f * float(r % sides) / float(sides)};
+                    const glm::vec3 direction{std::cos(angle) * side + std::sin(angle) * normal};
+                    vertices[v + r] = position + direction * radius;
+                    normals[v + r] = direction;
+                    uvs[v + r] = {u, float(r) / float(sides)};
+                }
+            }
+        }
+    }
+
+    void WriteIndices(size_t num_samples, std::vector<uint32_t> & indices) const
+    {
+        const size_t ring{RingSize()};
+        indices.clear();
+        if (Settings.Shape == TessellationShape::Ribbon)
+        {
+            indices.reserve((num_samples - 1) * 6);
+            for (size_t s = 0; s + 1 < num_samples; ++s)
+            {
+                const uint32_t a{uint32_t(s * 2)}, b{uint32_t((s + 1) * 2)};
+                indices.insert(indices.end(), {a, a + 1, b, a + 1, b + 1, b});
+            }
+        }
+        else
+        {
+            indices.reserve((num_samples - 1) * (ring - 1) * 6);
+            for (size_t s = 0; s + 1 < num_samples; ++s)
+            {
+                const uint32_t a{uint32_t(s * ring)}, b{uint32_t((s + 1) * ring)};
+                for (uint32_t r = 0; r + 1 < ring; ++r)
+                {
+                    const uint32_t r1{r + 1};
+                    indices.insert(indices.end(), {a + r, b + r, a + r1, a + r1, b + r, b + r1});
+                }
+            }
+        }
+    }
+};
+
+} // namespace _implementation
+
+using _implementation::SplineTessellator;
+using _implementation::TessellationSettings;
+using _implementation::TessellationShape;
+using _implementation::TessellationUpdate;
+
+} // namespace My::Utility
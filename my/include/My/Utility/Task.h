@@ -0,0 +1,208 @@
+#pragma once
+
+#include "pch.h"
+
+#include <coroutine>
+#include <optional>
+#include <utility>
+
+namespace My::Utility
+{
+
+class JobSystem;
+
+template <typename value_t> class Task;
+
+/**
+ * @brief   State shared by all task promises.
+ *
+ * The continuation is the coroutine awaiting the task. Completion replaces it with a tag, so a task
+ * running on a worker and the coroutine starting to await it may race without a lock.
+ *
+ * @ingroup Utility
+ */
+class TaskPromiseBase
+{
+    friend class JobSystem;
+    template <typename> friend class Task;
+
+private:
+    static inline char FinishedTag{0}; // its address marks completion
+
+    std::atomic<void *> _continuation{nullptr};
+    bool _started{false};
+
+protected:
+    std::exception_ptr _exception;
+
+private:
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename promise_t>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_t> handle) noexcept
+        {
+            void * continuation = handle.promise()._continuation.exchange(&FinishedTag);
+            if (continuation) return std::coroutine_handle<>::from_address(continuation);
+            return std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+public:
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception() noexcept { _exception = std::current_exception(); }
+
+    bool Finished() const { return _continuation.load() == &FinishedTag; }
+};
+
+template <typename value_t> class TaskPromise : public TaskPromiseBase
+{
+private:
+    std::optional<value_t> _value;
+
+public:
+    Task<value_t> get_return_object() noexcept;
+
+    template <typename result_t> void return_value(result_t && value)
+    {
+        _value.emplace(std::forward<result_t>(value));
+    }
+
+    value_t Result()
+    {
+        if (_exception) std::rethrow_exception(_exception);
+        return std::move(*_value);
+    }
+};
+
+template <> class TaskPromise<void> : public TaskPromiseBase
+{
+public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    void Result()
+    {
+        if (_exception) std::rethrow_exception(_exception);
+    }
+};
+
+/**
+ * @brief   Lazily started coroutine producing a value_t.
+ *
+ * co_await starts the task on the awaiting thread (symmetric transfer) and resumes the awaiting
+ * coroutine when it completes. JobSystem::Start runs it on a worker instead, it may then be awaited
+ * later or waited for with JobSystem::Wait. Exceptions are rethrown to the awaiting coroutine.
+ *
+ * @code
+ * Task<Mesh> LoadMesh(JobSystem & jobs, std::wstring filename)
+ * {
+ *     co_await jobs.Schedule();            // continue on a worker
+ *     Mesh mesh = Parse(filename);
+ *     co_await jobs.MainThread();          // e.g. to touch the ECS
+ *     co_return mesh;
+ * }
+ * @endcode
+ *
+ * A started task must finish before it is destroyed.
+ *
+ * @tparam  value_t     The result type.
+ *
+ * @ingroup Utility
+ */
+template <typename value_t = void> class Task
+{
+    friend class JobSystem;
+
+public:
+    using promise_type = TaskPromise<value_t>;
+
+private:
+    std::coroutine_handle<promise_type> _handle;
+
+    struct Awaiter
+    {
+        std::coroutine_handle<promise_type> Handle;
+
+        bool await_ready() const noexcept { return Handle.promise().Finished(); }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+        {
+            promise_type & promise = Handle.promise();
+            if (!promise._started)
+            {
+                promise._started = true;
+                promise._continuation.store(awaiting.address());
+                return Handle;
+            }
+
+            void * expected = nullptr;
+            if (promise._continuation.compare_exchange_strong(expected, awaiting.address()))
+                return std::noop_coroutine();
+            return awaiting; // finished in the meantime
+        }
+
+        value_t await_resume() { return Handle.promise().Result(); }
+    };
+
+    // Constructors //
+public:
+    Task() = default;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : _handle{handle} {}
+
+    Task(Task && other) noexcept : _handle{std::exchange(other._handle, nullptr)} {}
+
+    Task & operator=(Task && other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            _handle = std::exchange(other._handle, nullptr);
+        }
+        return *this;
+    }
+
+    Task(const Task &) = delete;
+
+    Task & operator=(const Task &) = delete;
+
+    ~Task() { Reset(); }
+
+    // Interface //
+public:
+    bool Valid() const { return bool(_handle); }
+
+    bool Finished() const { return _handle && _handle.promise().Finished(); }
+
+    Awaiter operator co_await() const noexcept { return Awaiter{_handle}; }
+
+private:
+    void Reset()
+    {
+        if (!_handle) return;
+
+        assert(!_handle.promise()._started || _handle.promise().Finished());
+        _handle.destroy();
+        _handle = nullptr;
+    }
+};
+
+template <typename value_t> Task<value_t> TaskPromise<value_t>::get_return_object() noexcept
+{
+    return Task<value_t>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+    return Task<void>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+}
+
+} // namespace My::Utility
@@ -106,7 +106,7 @@ public:
         vector<glm::vec3> normals;
         vector<glm::vec2> UV;
 
-        EntityReference entity = entity_manager.CreateEntity();
+        EntityReference root = entity_manager.CreateEntity(); // one child per object
         MaterialPointer material;
 
         auto push_object = [&]() {
@@ -121,6 +121,8 @@ public:
 
             comp.MPointer = material;
 
+            EntityReference entity = entity_manager.CreateEntity();
+            entity_manager.SetParent(entity, root);
             component_manager.RegisterComponent(entity_manager, entity, comp);
 
             vertices.clear();
@@ -217,7 +219,7 @@ public:
         }
         if (vertices.size()) push_object();
 
-        return entity;
+        return root;
     }
 };
 
@@ -228,8 +230,8 @@ class WavefrontLoader
 {
 public:
     static EntityReference Load(std::wstring filename,          //
-                     EntityManager & entity_manager, //
-                     ComponentManager & component_manager)
+                                EntityManager & entity_manager, //
+                                ComponentManager & component_manager)
     {
         auto s = Split(filename, L'/');
         auto fname = s.back();
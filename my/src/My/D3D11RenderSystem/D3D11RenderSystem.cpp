@@ -21,39 +21,56 @@ void My::D3D11RenderSystem::_implementation::D3D11RenderSystem::UpdateComponents
     ComponentManager & manager)
 {
     const auto & mesh_components = manager.GetMeshComponentData();
-    for (size_t i = 0; i < mesh_components.size(); ++i)
+
+    // upload added and modified meshes, release the buffers of removed ones
+    // (in place edits of a MeshComponent are seen only if made through Modify / MarkModified)
+    const bool incremental =
+        mesh_components.Changes(_mesh_version, [&](const ChangeEvent & change) {
+            if (change.Type == ChangeType::Removed)
+                _mesh_buffers.Remove(change.Entity);
+            else if (const MeshComponent * component = mesh_components.Find(change.Entity))
+                _mesh_buffers.Add(change.Entity, CreateMeshBuffers(*component));
+        });
+
+    if (!incremental) // missed changes, upload everything
     {
-        auto & component = mesh_components[i];
-        if (i >= _vertex_buffers.size()) // TODO: Dirty Flag
-        {
-            // vertex data buffer
-            D3D11_BUFFER_DESC v_buffer_desc{0};
-            v_buffer_desc.ByteWidth =
-                static_cast<UINT>(sizeof(VERTEX_DATA) * component.Vertices.size());
-            v_buffer_desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-
-            auto data = MakeData(component);
-            D3D11_SUBRESOURCE_DATA v_sub_data{data.data(), 0, 0};
-
-            winrt::com_ptr<ID3D11Buffer> vertex_buffer{nullptr};
-            winrt::check_hresult(
-                _device->CreateBuffer(&v_buffer_desc, &v_sub_data, vertex_buffer.put()));
-
-            // index data buffer
-            D3D11_BUFFER_DESC i_buffer_desc{0};
-            i_buffer_desc.Usage = D3D11_USAGE_IMMUTABLE; // TODO: Maybe flag?
-            i_buffer_desc.ByteWidth = static_cast<UINT>(sizeof(UINT) * component.Indices.size());
-            i_buffer_desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
-
-            winrt::com_ptr<ID3D11Buffer> index_buffer{nullptr};
-            D3D11_SUBRESOURCE_DATA i_sub_data{component.Indices.data(), 0, 0};
-            winrt::check_hresult(
-                _device->CreateBuffer(&i_buffer_desc, &i_sub_data, index_buffer.put()));
-
-            _vertex_buffers.push_back(vertex_buffer);
-            _index_buffers.push_back(index_buffer);
-        }
+        for (size_t i = _mesh_buffers.Size(); i-- > 0;)
+            _mesh_buffers.Remove(_mesh_buffers.Entities()[i]);
+
+        for (size_t i = 0; i < mesh_components.Size(); ++i)
+            _mesh_buffers.Add(mesh_components.Entities()[i],
+                              CreateMeshBuffers(mesh_components[i]));
     }
+
+    _mesh_version = mesh_components.Version();
+}
+
+My::D3D11RenderSystem::_implementation::D3D11RenderSystem::MeshBuffers
+My::D3D11RenderSystem::_implementation::D3D11RenderSystem::CreateMeshBuffers(
+    const MeshComponent & component)
+{
+    // vertex data buffer
+    D3D11_BUFFER_DESC v_buffer_desc{0};
+    v_buffer_desc.ByteWidth = static_cast<UINT>(sizeof(VERTEX_DATA) * component.Vertices.size());
+    v_buffer_desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+
+    auto data = MakeData(component);
+    D3D11_SUBRESOURCE_DATA v_sub_data{data.data(), 0, 0};
+
+    winrt::com_ptr<ID3D11Buffer> vertex_buffer{nullptr};
+    winrt::check_hresult(_device->CreateBuffer(&v_buffer_desc, &v_sub_data, vertex_buffer.put()));
+
+    // index data buffer
+    D3D11_BUFFER_DESC i_buffer_desc{0};
+    i_buffer_desc.Usage = D3D11_USAGE_IMMUTABLE; // TODO: Maybe flag?
+    i_buffer_desc.ByteWidth = static_cast<UINT>(sizeof(UINT) * component.Indices.size());
+    i_buffer_desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+
+    winrt::com_ptr<ID3D11Buffer> index_buffer{nullptr};
+    D3D11_SUBRESOURCE_DATA i_sub_data{component.Indices.data(), 0, 0};
+    winrt::check_hresult(_device->CreateBuffer(&i_buffer_desc, &i_sub_data, index_buffer.put()));
+
+    return MeshBuffers{vertex_buffer, index_buffer};
 }
 
 std::vector<My::D3D11RenderSystem::VERTEX_DATA>
@@ -383,17 +400,17 @@ void My::D3D11RenderSystem::_implementation::D3D11RenderSystem::RenderXR(
     constant_vs.ProjectionMatrix[1] = r_proj;
     constant_vs.NormalMatrix = XMMatrixIdentity();
 
-    auto point_light_components = component_manager.GetPointLightComponentData();
+    const auto & point_light_components = component_manager.GetPointLightComponentData();
 
     XMVECTOR lights[MAX_NUMBER_LIGHTS];
 
     size_t i = 0;
 
-    for (; i < std::min<size_t>(MAX_NUMBER_LIGHTS, point_light_components.size()); ++i)
+    for (; i < std::min<size_t>(MAX_NUMBER_LIGHTS, point_light_components.Size()); ++i)
     {
-        lights[i] =
-            XMVectorSetByIndex(cvx(entity_manager[point_light_components[i].Parent.Index].Position),
-                               point_light_components[i].Intensity, 3);
+        const PointLightComponent & light = point_light_components[i];
+        const glm::vec3 position{entity_manager.WorldMatrix(light.Parent)[3]};
+        lights[i] = XMVectorSetByIndex(cvx(position), light.Intensity, 3);
     }
 
     for (; i < MAX_NUMBER_LIGHTS; ++i) lights[i] = XMVectorSet(0, 0, 0, 0);
@@ -402,22 +419,17 @@ void My::D3D11RenderSystem::_implementation::D3D11RenderSystem::RenderXR(
 
     UpdateComponents(component_manager);
 
-    auto mesh_components = component_manager.GetMeshComponentData();
-    for (size_t i = 0; i < mesh_components.size(); ++i)
-    {
-        const MeshComponent & mesh_component = mesh_components[i];
+    View<const MeshComponent, const MeshBuffers> meshes{component_manager.Storage<MeshComponent>(),
+                                                        _mesh_buffers};
+    meshes.Each([&](EntityReference entity, const MeshComponent & mesh_component,
+                    const MeshBuffers & buffers) {
         auto & material_pointer = mesh_component.MPointer;
 
         _device_context->RSSetState(mesh_component.Wireframe ? _rasterizer_state_wf.get()
                                                              : _rasterizer_state_solid.get());
 
-        auto & entity = entity_manager[mesh_component.Parent.Index];
-        constant_vs.ModelMatrix = XMMatrixAffineTransformation(
-            cvx(entity.Scale), XMVectorSet(0, 0, 0, 0), cvx(entity.Rotation), cvx(entity.Position));
-
-        XMVECTOR det{0};
-        constant_vs.NormalMatrix =
-            XMMATRIX(XMMatrixTranspose(XMMatrixInverse(&det, constant_vs.ModelMatrix)));
+        constant_vs.ModelMatrix = cvx(entity_manager.WorldMatrix(entity));
+        constant_vs.NormalMatrix = cvx(entity_manager.NormalMatrix(entity));
 
         D3D11_MAPPED_SUBRESOURCE subres{0};
         winrt::check_hresult(
@@ -441,9 +453,9 @@ void My::D3D11RenderSystem::_implementation::D3D11RenderSystem::RenderXR(
         }
 
         UINT stride{sizeof(VERTEX_DATA)}, offset{0};
-        auto * v_buffer = _vertex_buffers[i].get(); // simulate array
+        auto * v_buffer = buffers.Vertices.get(); // simulate array
         _device_context->IASetVertexBuffers(0, 1, &v_buffer, &stride, &offset);
-        _device_context->IASetIndexBuffer(_index_buffers[i].get(), DXGI_FORMAT_R32_UINT, 0);
+        _device_context->IASetIndexBuffer(buffers.Indices.get(), DXGI_FORMAT_R32_UINT, 0);
 
         _device_context->IASetPrimitiveTopology(
             D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST); // TODO: Flag
@@ -454,5 +466,5 @@ void My::D3D11RenderSystem::_implementation::D3D11RenderSystem::RenderXR(
             0,                                                 // Base vertex Location.
             0                                                  // Start Instance Location
         );
-    }
+    });
 }
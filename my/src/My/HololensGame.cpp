@@ -1,9 +1,13 @@
 #include "pch.h"
 
+#include "My/Engine/AnimationSystem.h"
 #include "My/Engine/ComponentManager.h"
 #include "My/Engine/EntityManager.h"
 #include "My/Engine/Game.h"
+#include "My/Engine/SystemScheduler.h"
+#include "My/Engine/TransformSystem.h"
 
+#include "My/Utility/JobSystem.h"
 #include "My/Utility/MeshLoader.h"
 
 #include "My/D3D11RenderSystem/D3D11RenderSystem.h"
@@ -94,18 +98,25 @@ private:
 
     bool _animate{true};
 
+    My::Utility::JobSystem _jobs;
     ComponentManager _component_manager;
     EntityManager _entity_manager;
     My::D3D11RenderSystem::D3D11RenderSystem _render_system;
+    AnimationSystem _animation_system;
+    TransformSystem _transform_system;
+    SystemScheduler _scheduler;
 
-    EntityReference _object{0};
+    EntityReference _object;
     bool _initialized{false};
 
     // Constructors/Methods //
 public:
     HololensGame(std::string application_name = "MyLens")
         : _application_name(std::move(application_name))
-    {}
+    {
+        _scheduler.Add(_animation_system);
+        _scheduler.Add(_transform_system); // after the systems moving entities
+    }
 
     void Run() override
     {
@@ -153,18 +164,16 @@ public:
     }
 
 private:
-    float _phi{0.f};
     uint32_t _target_hand{0};
     void UpdateScene(XrFrameState & state)
     {
+        _component_manager.NextFrame();
+        _jobs.RunMainThreadJobs();
+
         if (_initialized)
         {
-            if (_animate)
-            {
-                _phi -= .005f;
-                _entity_manager[_object.Index].Rotation = My::Math::RollPitchYaw(0.f, _phi, 0.f);
-            }
-            else
+            _animation_system.Enabled = _animate;
+            if (!_animate)
             {
                 XrSpaceLocation hand_location{XR_TYPE_SPACE_LOCATION};
                 XrTime time = state.predictedDisplayTime;
@@ -174,9 +183,12 @@ private:
                 if (xr::math::Pose::IsPoseValid(hand_location))
                 {
                     auto & pos = hand_location.pose.position;
-                    _entity_manager[_object.Index].Position = glm::vec3(pos.x, pos.y, pos.z);
+                    _entity_manager.Position(_object) = glm::vec3(pos.x, pos.y, pos.z);
                 }
             }
+
+            const float delta_time = state.predictedDisplayPeriod * 1e-9f; // ns
+            _scheduler.Run(SystemContext{delta_time, _entity_manager, _component_manager, _jobs});
         }
     }
 
@@ -189,10 +201,22 @@ private:
                                             _entity_manager,                //
                                             _component_manager);
 
+        // one turn around the pitch axis every 20 seconds
+        constexpr float Period = 20.f, Turn = -2.f * 3.14159265f;
+        auto spin = std::make_shared<AnimationCurve>(2, My::Math::Intervall<float>{0.f, Period});
+        spin->specify(1, {0.f, Turn, 0.f});
+        spin->specifyDerivative({0.f, Turn / Period, 0.f}); // constant speed
+        spin->generate();
+
+        SplineAnimationComponent spin_component;
+        spin_component.Active = true;
+        spin_component.Track(AnimationChannel::Rotation).Curve = spin;
+        _component_manager.RegisterComponent(_entity_manager, _object, spin_component);
+
         auto light_entity = _entity_manager.CreateEntity();
         PointLightComponent light_component;
         light_component.Intensity = 100.f;
-        _entity_manager[light_entity.Index].Position = glm::vec3(1, 0, 1);
+        _entity_manager.Position(light_entity) = glm::vec3(1, 0, 1);
         _component_manager.RegisterComponent(_entity_manager, light_entity, light_component);
 
         _initialized = true;
@@ -0,0 +1,58 @@
+#include "pch.h"
+
+#include "My/Utility/MappedFile.h"
+
+My::Utility::MappedFile::MappedFile(const std::wstring & filename)
+{
+    _file = CreateFile2(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, nullptr);
+    if (_file == INVALID_HANDLE_VALUE) throw std::runtime_error("Could not open file.");
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(_file, &size))
+    {
+        Close();
+        throw std::runtime_error("Could not read file size.");
+    }
+    _size = size_t(size.QuadPart);
+    if (_size == 0) return; // empty files can not be mapped
+
+    _mapping = CreateFileMappingFromApp(_file, nullptr, PAGE_READONLY, 0, nullptr);
+    if (_mapping) _data = MapViewOfFileFromApp(_mapping, FILE_MAP_READ, 0, 0);
+    if (!_data)
+    {
+        Close();
+        throw std::runtime_error("Could not map file.");
+    }
+}
+
+My::Utility::MappedFile::MappedFile(MappedFile && o) noexcept
+    : _file{std::exchange(o._file, INVALID_HANDLE_VALUE)},
+      _mapping{std::exchange(o._mapping, nullptr)}, _data{std::exchange(o._data, nullptr)},
+      _size{std::exchange(o._size, 0)}
+{}
+
+My::Utility::MappedFile::~MappedFile() { Close(); }
+
+My::Utility::MappedFile & My::Utility::MappedFile::operator=(MappedFile && o) noexcept
+{
+    if (this != &o)
+    {
+        Close();
+        _file = std::exchange(o._file, INVALID_HANDLE_VALUE);
+        _mapping = std::exchange(o._mapping, nullptr);
+        _data = std::exchange(o._data, nullptr);
+        _size = std::exchange(o._size, 0);
+    }
+    return *this;
+}
+
+void My::Utility::MappedFile::Close() noexcept
+{
+    if (_data) UnmapViewOfFile(_data);
+    if (_mapping) CloseHandle(_mapping);
+    if (_file != INVALID_HANDLE_VALUE) CloseHandle(_file);
+    _data = nullptr;
+    _mapping = nullptr;
+    _file = INVALID_HANDLE_VALUE;
+    _size = 0;
+}